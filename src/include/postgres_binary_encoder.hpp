@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_binary_encoder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "postgres_utils.hpp"
+
+namespace duckdb {
+class PostgresBinaryWriter;
+
+struct PostgresEncoderColumn {
+	PostgresEncoderColumn();
+	~PostgresEncoderColumn();
+	PostgresEncoderColumn(PostgresEncoderColumn &&other) noexcept;
+
+	//! Columns of types without a specialized kernel are encoded a row at a time before the chunk is assembled
+	unique_ptr<PostgresBinaryWriter> writer;
+	//! The offset of every row in the stream of the writer (count + 1 entries)
+	vector<idx_t> offsets;
+	//! Whether or not NULL bytes have to be replaced in the (VARCHAR) values of the column
+	bool replace_null_bytes = false;
+};
+
+//! Encodes chunks into the binary COPY format a column at a time. The encoded size of every row is computed first,
+//! after which every column is written across all rows into a single buffer of exactly the required size.
+class PostgresBinaryEncoder {
+public:
+	explicit PostgresBinaryEncoder(PostgresCopyState &state);
+
+	//! Encode the rows of the chunk - the chunk is flattened
+	void Encode(DataChunk &chunk);
+
+	data_ptr_t GetData() {
+		return state.encode_buffer.get();
+	}
+	idx_t GetSize() const {
+		return size;
+	}
+
+private:
+	//! The Postgres type of the column - if known
+	optional_ptr<const PostgresType> GetPostgresType(idx_t column_idx) const;
+	void ComputeSizes(idx_t column_idx, Vector &col, idx_t count);
+	void EncodeRows(PostgresEncoderColumn &column, Vector &col, idx_t count, optional_ptr<const PostgresType> pg_type);
+	void WriteColumn(idx_t column_idx, Vector &col, idx_t count);
+
+private:
+	PostgresCopyState &state;
+	idx_t size = 0;
+	//! The encoded size of every row while computing sizes - the write position of every row afterwards
+	vector<idx_t> row_positions;
+	vector<PostgresEncoderColumn> columns;
+};
+
+} // namespace duckdb
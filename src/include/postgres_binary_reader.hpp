@@ -10,8 +10,31 @@
 
 #include "postgres_result_reader.hpp"
 #include "postgres_connection.hpp"
+#include "postgres_copy_prefetcher.hpp"
 
 namespace duckdb {
+struct PostgresBinaryReader;
+struct PostgresColumnDecoder;
+
+typedef void (*postgres_decode_function_t)(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+                                           Vector &out_vec, idx_t output_offset, idx_t value_len);
+//! Decodes one column of a batch of rows - fields points to the value of the first row (or nullptr for NULL), the
+//! values of subsequent rows are field_stride entries apart
+typedef void (*postgres_batch_decode_function_t)(const const_data_ptr_t *fields, idx_t field_stride, idx_t count,
+                                                 Vector &out_vec, idx_t output_offset);
+
+//! Pre-resolved decoder for a single column of the COPY output
+struct PostgresColumnDecoder {
+	postgres_decode_function_t decode;
+	optional_ptr<const LogicalType> type;
+	optional_ptr<const PostgresType> postgres_type;
+	//! The exact length of every (non-NULL) value of this column, or -1 if the length is variable
+	int32_t fixed_length = -1;
+	//! Column-at-a-time decoder, only set for fixed-length columns
+	postgres_batch_decode_function_t batch_decode = nullptr;
+	//! The buffer generation that was last attached to the output vector (for zero-copy strings)
+	mutable idx_t attached_generation = DConstants::INVALID_INDEX;
+};
 
 struct PostgresBinaryReader : public PostgresResultReader {
 	explicit PostgresBinaryReader(PostgresConnection &con, const vector<column_t> &column_ids,
@@ -21,15 +44,34 @@ struct PostgresBinaryReader : public PostgresResultReader {
 public:
 	void BeginCopy(const string &sql) override;
 	PostgresReadResult Read(DataChunk &result) override;
+	bool SupportsPrefetch() const override;
 
 protected:
 	bool Next();
+	bool NextPrefetched();
+	//! Fetch the next message only if it is available without receiving more data - the current message (and any
+	//! message returned previously by NextBuffered) remains valid
+	bool NextBuffered(data_ptr_t &message_ptr, data_ptr_t &message_end);
+	void ReadPrefetchedMessage(data_ptr_t &message_ptr, data_ptr_t &message_end);
 
 	void Reset();
 	bool Ready();
 
 	void CheckHeader();
 
+	//! Resolve the decoders for the projected columns
+	void InitializeDecoders();
+	//! Verify that all fields of the current row fit within the message
+	void VerifyRow(idx_t field_count);
+	//! Create a string_t for a string stored in the current message - if the message is stored in a buffer that is
+	//! owned by the reader the string references the buffer directly, otherwise it is copied into the vector
+	string_t ReferenceString(const PostgresColumnDecoder &decoder, Vector &out_vec, const char *str, idx_t len);
+	//! Decode the current message and all subsequent buffered messages column-at-a-time - only possible if all
+	//! columns have a fixed length. Returns false if the current message is not a regular row.
+	bool ReadFixedWidthBatch(DataChunk &output);
+	//! Locate the fields of a row for ReadFixedWidthBatch
+	void LocateFields(const_data_ptr_t row_ptr, const_data_ptr_t row_end, const_data_ptr_t *fields);
+
 protected:
 	template <class T>
 	inline T ReadIntegerUnchecked() {
@@ -53,31 +95,35 @@ protected:
 		return buffer_ptr >= end;
 	}
 
-	template <class T>
+	template <class T, bool CHECK_BOUNDS = true>
 	inline T ReadInteger() {
-		if (buffer_ptr + sizeof(T) > end) {
+		if (CHECK_BOUNDS && buffer_ptr + sizeof(T) > end) {
 			throw IOException("Postgres scanner - out of buffer in ReadInteger");
 		}
 		return ReadIntegerUnchecked<T>();
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline bool ReadBoolean() {
-		auto i = ReadInteger<uint8_t>();
+		auto i = ReadInteger<uint8_t, CHECK_BOUNDS>();
 		return i > 0;
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline float ReadFloat() {
-		auto i = ReadInteger<uint32_t>();
+		auto i = ReadInteger<uint32_t, CHECK_BOUNDS>();
 		return *reinterpret_cast<float *>(&i);
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline double ReadDouble() {
-		auto i = ReadInteger<uint64_t>();
+		auto i = ReadInteger<uint64_t, CHECK_BOUNDS>();
 		return *reinterpret_cast<double *>(&i);
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline date_t ReadDate() {
-		auto jd = ReadInteger<uint32_t>();
+		auto jd = ReadInteger<uint32_t, CHECK_BOUNDS>();
 		if (jd == POSTGRES_DATE_INF) {
 			return date_t::infinity();
 		}
@@ -87,18 +133,21 @@ protected:
 		return date_t(jd + POSTGRES_EPOCH_JDATE - DUCKDB_EPOCH_DATE); // magic!
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline dtime_t ReadTime() {
-		return dtime_t(ReadInteger<uint64_t>());
+		return dtime_t(ReadInteger<uint64_t, CHECK_BOUNDS>());
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline dtime_tz_t ReadTimeTZ() {
-		auto usec = ReadInteger<uint64_t>();
-		auto tzoffset = ReadInteger<int32_t>();
+		auto usec = ReadInteger<uint64_t, CHECK_BOUNDS>();
+		auto tzoffset = ReadInteger<int32_t, CHECK_BOUNDS>();
 		return dtime_tz_t(dtime_t(usec), -tzoffset);
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline timestamp_t ReadTimestamp() {
-		auto usec = ReadInteger<uint64_t>();
+		auto usec = ReadInteger<uint64_t, CHECK_BOUNDS>();
 		if (usec == POSTGRES_INFINITY) {
 			return timestamp_t::infinity();
 		}
@@ -108,24 +157,27 @@ protected:
 		return timestamp_t(usec + (POSTGRES_EPOCH_TS - DUCKDB_EPOCH_TS));
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline interval_t ReadInterval() {
 		interval_t res;
-		res.micros = ReadInteger<uint64_t>();
-		res.days = ReadInteger<uint32_t>();
-		res.months = ReadInteger<uint32_t>();
+		res.micros = ReadInteger<uint64_t, CHECK_BOUNDS>();
+		res.days = ReadInteger<uint32_t, CHECK_BOUNDS>();
+		res.months = ReadInteger<uint32_t, CHECK_BOUNDS>();
 		return res;
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	inline hugeint_t ReadUUID() {
 		hugeint_t res;
-		auto upper = ReadInteger<uint64_t>();
+		auto upper = ReadInteger<uint64_t, CHECK_BOUNDS>();
 		res.upper = upper ^ (int64_t(1) << 63);
-		res.lower = ReadInteger<uint64_t>();
+		res.lower = ReadInteger<uint64_t, CHECK_BOUNDS>();
 		return res;
 	}
 
+	template <bool CHECK_BOUNDS = true>
 	const char *ReadString(idx_t string_length) {
-		if (buffer_ptr + string_length > end) {
+		if (CHECK_BOUNDS && buffer_ptr + string_length > end) {
 			throw IOException("Postgres scanner - out of buffer in ReadString");
 		}
 		auto result = const_char_ptr_cast(buffer_ptr);
@@ -203,11 +255,80 @@ protected:
 	               uint32_t current_count, uint32_t dimensions[], uint32_t ndim);
 
 	void ReadValue(const LogicalType &type, const PostgresType &postgres_type, Vector &out_vec, idx_t output_offset);
+	void ReadValueData(const LogicalType &type, const PostgresType &postgres_type, Vector &out_vec, idx_t output_offset,
+	                   int32_t value_len);
+
+	// decoders for the fields of a verified row - these can skip bounds checks for fixed-length values
+	template <class T>
+	static void DecodeInteger(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                          idx_t output_offset, idx_t value_len);
+	static void DecodeCTID(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                       idx_t output_offset, idx_t value_len);
+	static void DecodeBoolean(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                          idx_t output_offset, idx_t value_len);
+	static void DecodeFloat(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                        idx_t output_offset, idx_t value_len);
+	static void DecodeDouble(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                         idx_t output_offset, idx_t value_len);
+	static void DecodeDate(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                       idx_t output_offset, idx_t value_len);
+	static void DecodeTime(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                       idx_t output_offset, idx_t value_len);
+	static void DecodeTimeTZ(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                         idx_t output_offset, idx_t value_len);
+	static void DecodeTimestamp(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                            idx_t output_offset, idx_t value_len);
+	static void DecodeInterval(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                           idx_t output_offset, idx_t value_len);
+	static void DecodeUUID(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                       idx_t output_offset, idx_t value_len);
+	static void DecodeString(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                         idx_t output_offset, idx_t value_len);
+	static void DecodeGeneric(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder, Vector &out_vec,
+	                          idx_t output_offset, idx_t value_len);
+
+	// column-at-a-time decoders for batches of rows with only fixed-length columns
+	template <class T>
+	static void BatchDecodeInteger(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                               idx_t output_offset);
+	static void BatchDecodeCTID(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                            idx_t output_offset);
+	static void BatchDecodeBoolean(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                               idx_t output_offset);
+	static void BatchDecodeFloat(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                             idx_t output_offset);
+	static void BatchDecodeDouble(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                              idx_t output_offset);
+	static void BatchDecodeDate(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                            idx_t output_offset);
+	static void BatchDecodeTime(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                            idx_t output_offset);
+	static void BatchDecodeTimeTZ(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                              idx_t output_offset);
+	static void BatchDecodeTimestamp(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                                 idx_t output_offset);
+	static void BatchDecodeInterval(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                                idx_t output_offset);
+	static void BatchDecodeUUID(const const_data_ptr_t *fields, idx_t field_stride, idx_t count, Vector &out_vec,
+	                            idx_t output_offset);
 
 private:
 	data_ptr_t buffer = nullptr;
 	data_ptr_t buffer_ptr = nullptr;
 	data_ptr_t end = nullptr;
+	//! The decoders of the projected columns
+	vector<PostgresColumnDecoder> decoders;
+	//! Whether or not all projected columns can be decoded in batches
+	bool batch_decode = false;
+	//! The field locations of the current batch (row-major)
+	vector<const_data_ptr_t> batch_fields;
+	//! Background receiver of COPY data (if pg_use_prefetch is enabled)
+	unique_ptr<PostgresCopyPrefetcher> prefetcher;
+	shared_ptr<PostgresCopyBuffer> prefetch_buffer;
+	idx_t prefetch_offset = 0;
+	//! Incremented whenever strings need to reference a different buffer (or a new output chunk is started)
+	idx_t buffer_generation = 0;
+	bool expect_header = true;
 };
 
 } // namespace duckdb
@@ -11,6 +11,7 @@
 #include "duckdb.hpp"
 #include "duckdb/common/types/interval.hpp"
 #include "duckdb/common/serializer/memory_stream.hpp"
+#include "postgres_utils.hpp"
 #include "postgres_conversion.hpp"
 
 namespace duckdb {
@@ -21,7 +22,7 @@ public:
 	}
 
 	template <class T>
-	T GetInteger(T val) {
+	static T GetInteger(T val) {
 		if (sizeof(T) == sizeof(uint8_t)) {
 			return val;
 		} else if (sizeof(T) == sizeof(uint16_t)) {
@@ -212,9 +213,7 @@ public:
 		auto str_data = value.GetData();
 		if (memchr(str_data, '\0', str_size) != nullptr) {
 			if (!state.has_null_byte_replacement) {
-				throw InvalidInputException("Attempting to write a VARCHAR value with a NULL-byte. Postgres does not "
-				                            "support NULL-bytes in VARCHAR values.\n* SET pg_null_byte_replacement='' "
-				                            "to remove NULL bytes or replace them with another character");
+				ThrowNullByteException();
 			}
 			// we have a NULL byte replacement - construct a new string that has all null bytes replaced and write it
 			// out
@@ -232,7 +231,14 @@ public:
 		WriteRawBlob(value);
 	}
 
-	void WriteArray(Vector &col, idx_t r, const vector<uint32_t> &dimensions, idx_t depth, uint32_t count) {
+	static void ThrowNullByteException() {
+		throw InvalidInputException("Attempting to write a VARCHAR value with a NULL-byte. Postgres does not "
+		                            "support NULL-bytes in VARCHAR values.\n* SET pg_null_byte_replacement='' "
+		                            "to remove NULL bytes or replace them with another character");
+	}
+
+	void WriteArray(Vector &col, idx_t r, const vector<uint32_t> &dimensions, idx_t depth, uint32_t count,
+	                optional_ptr<const PostgresType> element_type) {
 		auto list_data = FlatVector::GetData<list_entry_t>(col);
 		auto &child_vector = ListVector::GetEntry(col);
 		for (idx_t i = 0; i < count; i++) {
@@ -242,18 +248,223 @@ public:
 				                            "found a length mismatch (found %llu entries, expected %llu)",
 				                            list_entry.length, dimensions[depth]);
 			}
-			if (child_vector.GetType().id() == LogicalTypeId::LIST) {
+			if (depth + 1 < dimensions.size()) {
 				// multidimensional array - recurse
-				WriteArray(child_vector, list_entry.offset, dimensions, depth + 1, list_entry.length);
+				WriteArray(child_vector, list_entry.offset, dimensions, depth + 1, list_entry.length, element_type);
 			} else {
 				// write the actual values
 				for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
-					WriteValue(child_vector, list_entry.offset + child_idx);
+					if (element_type) {
+						WriteValue(child_vector, list_entry.offset + child_idx, *element_type);
+					} else {
+						WriteValue(child_vector, list_entry.offset + child_idx);
+					}
 				}
 			}
 		}
 	}
 
+	//! Write a list as a (multidimensional) array - if the Postgres type is known its element oid is written
+	void WriteList(Vector &col, idx_t r, optional_ptr<const PostgresType> pg_type) {
+		auto &type = col.GetType();
+		auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
+		// find the type of the array elements - multidimensional arrays are nested lists
+		// geometric types are lists as well, but are written as elements
+		const_reference<LogicalType> element_type = ListType::GetChildType(type);
+		optional_ptr<const PostgresType> element_pg_type;
+		if (pg_type) {
+			D_ASSERT(pg_type->children.size() == 1);
+			element_pg_type = &pg_type->children[0];
+		}
+		idx_t ndim = 1;
+		while (element_type.get().id() == LogicalTypeId::LIST &&
+		       (!element_pg_type || element_pg_type->info == PostgresTypeAnnotation::STANDARD)) {
+			element_type = ListType::GetChildType(element_type.get());
+			if (element_pg_type) {
+				D_ASSERT(element_pg_type->children.size() == 1);
+				element_pg_type = &element_pg_type->children[0];
+			}
+			ndim++;
+		}
+		uint32_t value_oid;
+		if (element_pg_type && element_pg_type->oid != 0) {
+			value_oid = NumericCast<uint32_t>(element_pg_type->oid);
+		} else {
+			value_oid = PostgresUtils::ToPostgresOid(element_type.get());
+		}
+		if (list_entry.length == 0) {
+			// empty list
+			WriteRawInteger<int32_t>(sizeof(uint32_t) * 3);
+			WriteRawInteger<uint32_t>(0);
+			WriteRawInteger<uint32_t>(0);
+			WriteRawInteger<uint32_t>(value_oid);
+			return;
+		}
+		// compute how many dimensions we will write
+		vector<uint32_t> dimensions;
+		const_reference<Vector> current_vector = col;
+		idx_t current_position = r;
+		for (idx_t dim = 0; dim < ndim; dim++) {
+			auto current_entry = FlatVector::GetData<list_entry_t>(current_vector.get())[current_position];
+			dimensions.push_back(current_entry.length);
+			current_vector = ListVector::GetEntry(current_vector.get());
+			current_position = current_entry.offset;
+		}
+
+		// list header
+		// record the location of the field size in the stream
+		auto start_position = stream.GetPosition();
+		WriteRawInteger<int32_t>(0);                  // data size (nop for now)
+		WriteRawInteger<uint32_t>(dimensions.size()); // ndim
+		WriteRawInteger<uint32_t>(1);                 // has nulls
+		WriteRawInteger<uint32_t>(value_oid);         // value_oid
+		// write the dimensions of the arrays
+		for (auto &dim : dimensions) {
+			WriteRawInteger<uint32_t>(dim); // array length
+			WriteRawInteger<uint32_t>(1);   // index lower bounds
+		}
+		// now recursively write the actual values
+		WriteArray(col, r, dimensions, 0, 1, element_pg_type);
+
+		// after writing all list elements update the field size
+		auto end_position = stream.GetPosition();
+		auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
+		Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+	}
+
+	//! Write a struct as a record - if the Postgres type is known the oids of its attributes are written
+	void WriteStruct(Vector &col, idx_t r, optional_ptr<const PostgresType> pg_type) {
+		auto &child_entries = StructVector::GetEntries(col);
+		D_ASSERT(!pg_type || pg_type->children.size() == child_entries.size());
+
+		auto start_position = stream.GetPosition();
+		WriteRawInteger<int32_t>(0);                     // data size (nop for now)
+		WriteRawInteger<uint32_t>(child_entries.size()); // column count
+		for (idx_t c = 0; c < child_entries.size(); c++) {
+			auto &child = *child_entries[c];
+			if (pg_type && pg_type->children[c].oid != 0) {
+				WriteRawInteger<uint32_t>(NumericCast<uint32_t>(pg_type->children[c].oid)); // value oid
+				WriteValue(child, r, pg_type->children[c]);
+			} else {
+				WriteRawInteger<uint32_t>(PostgresUtils::ToPostgresOid(child.GetType())); // value oid
+				WriteValue(child, r);
+			}
+		}
+		auto end_position = stream.GetPosition();
+		// after writing all list elements update the field size
+		auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
+		Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+	}
+
+	void WriteJSONB(string_t value) {
+		// jsonb is sent as a version number followed by the JSON text
+		auto str_size = value.GetSize();
+		WriteRawInteger<int32_t>(NumericCast<int32_t>(str_size + 1));
+		WriteRawInteger<uint8_t>(1);
+		stream.WriteData(const_data_ptr_cast(value.GetData()), str_size);
+	}
+
+	void WriteRawDouble(double value) {
+		WriteRawInteger<uint64_t>(Load<uint64_t>(const_data_ptr_cast(&value)));
+	}
+
+	void WritePoint(Vector &col, idx_t r) {
+		auto &child_entries = StructVector::GetEntries(col);
+		D_ASSERT(child_entries.size() == 2);
+		if (FlatVector::IsNull(*child_entries[0], r) || FlatVector::IsNull(*child_entries[1], r)) {
+			throw InvalidInputException("Postgres POINT values cannot have NULL coordinates");
+		}
+		WriteRawInteger<int32_t>(sizeof(double) * 2);
+		WriteRawDouble(FlatVector::GetData<double>(*child_entries[0])[r]);
+		WriteRawDouble(FlatVector::GetData<double>(*child_entries[1])[r]);
+	}
+
+	//! Write a geometric type that is represented as a list of doubles - the inverse of ReadGeometry
+	void WriteGeometry(Vector &col, idx_t r, PostgresTypeAnnotation info) {
+		auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
+		auto &child_vector = ListVector::GetEntry(col);
+		auto child_data = FlatVector::GetData<double>(child_vector);
+		idx_t element_count = 0;
+		idx_t header_size = 0;
+		switch (info) {
+		case PostgresTypeAnnotation::GEOM_LINE:
+		case PostgresTypeAnnotation::GEOM_CIRCLE:
+			element_count = 3;
+			break;
+		case PostgresTypeAnnotation::GEOM_LINE_SEGMENT:
+		case PostgresTypeAnnotation::GEOM_BOX:
+			element_count = 4;
+			break;
+		case PostgresTypeAnnotation::GEOM_PATH:
+			// closed flag + point count
+			header_size = sizeof(uint8_t) + sizeof(uint32_t);
+			break;
+		case PostgresTypeAnnotation::GEOM_POLYGON:
+			// point count
+			header_size = sizeof(uint32_t);
+			break;
+		default:
+			throw InternalException("Unsupported type for WriteGeometry");
+		}
+		if (element_count == 0 ? list_entry.length % 2 != 0 : list_entry.length != element_count) {
+			throw InvalidInputException("Invalid Postgres geometric value - found %llu coordinates", list_entry.length);
+		}
+		for (idx_t i = 0; i < list_entry.length; i++) {
+			if (FlatVector::IsNull(child_vector, list_entry.offset + i)) {
+				throw InvalidInputException("Postgres geometric values cannot have NULL coordinates");
+			}
+		}
+		WriteRawInteger<int32_t>(NumericCast<int32_t>(header_size + list_entry.length * sizeof(double)));
+		if (info == PostgresTypeAnnotation::GEOM_PATH) {
+			// paths are read without their closed flag - write them as open paths
+			WriteRawInteger<uint8_t>(0);
+		}
+		if (header_size > 0) {
+			WriteRawInteger<uint32_t>(NumericCast<uint32_t>(list_entry.length / 2));
+		}
+		for (idx_t i = 0; i < list_entry.length; i++) {
+			WriteRawDouble(child_data[list_entry.offset + i]);
+		}
+	}
+
+	//! Write a value of a column with a known Postgres type - annotated types are written in the format of the
+	//! Postgres type, and the oids of nested types are taken from the Postgres type
+	void WriteValue(Vector &col, idx_t r, const PostgresType &pg_type) {
+		if (FlatVector::IsNull(col, r)) {
+			WriteNull();
+			return;
+		}
+		switch (pg_type.info) {
+		case PostgresTypeAnnotation::JSONB:
+			WriteJSONB(FlatVector::GetData<string_t>(col)[r]);
+			return;
+		case PostgresTypeAnnotation::GEOM_POINT:
+			WritePoint(col, r);
+			return;
+		case PostgresTypeAnnotation::GEOM_LINE:
+		case PostgresTypeAnnotation::GEOM_LINE_SEGMENT:
+		case PostgresTypeAnnotation::GEOM_BOX:
+		case PostgresTypeAnnotation::GEOM_PATH:
+		case PostgresTypeAnnotation::GEOM_POLYGON:
+		case PostgresTypeAnnotation::GEOM_CIRCLE:
+			WriteGeometry(col, r, pg_type.info);
+			return;
+		default:
+			break;
+		}
+		switch (col.GetType().id()) {
+		case LogicalTypeId::LIST:
+			WriteList(col, r, &pg_type);
+			break;
+		case LogicalTypeId::STRUCT:
+			WriteStruct(col, r, &pg_type);
+			break;
+		default:
+			WriteValue(col, r);
+			break;
+		}
+	}
+
 	void WriteValue(Vector &col, idx_t r) {
 		if (FlatVector::IsNull(col, r)) {
 			WriteNull();
@@ -372,66 +583,12 @@ public:
 			WriteVarchar(EnumType::GetString(type, pos));
 			break;
 		}
-		case LogicalTypeId::LIST: {
-			auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
-			auto value_oid = PostgresUtils::ToPostgresOid(ListType::GetChildType(type));
-			if (list_entry.length == 0) {
-				// empty list
-				WriteRawInteger<int32_t>(sizeof(uint32_t) * 3);
-				WriteRawInteger<uint32_t>(0);
-				WriteRawInteger<uint32_t>(0);
-				WriteRawInteger<uint32_t>(value_oid);
-				return;
-			}
-			// compute how many dimensions we will write
-			vector<uint32_t> dimensions;
-			const_reference<Vector> current_vector = col;
-			idx_t current_position = r;
-			while (current_vector.get().GetType().id() == LogicalTypeId::LIST) {
-				auto current_entry = FlatVector::GetData<list_entry_t>(current_vector.get())[current_position];
-				dimensions.push_back(current_entry.length);
-				current_vector = ListVector::GetEntry(current_vector.get());
-				current_position = current_entry.offset;
-			}
-
-			// list header
-			// record the location of the field size in the stream
-			auto start_position = stream.GetPosition();
-			WriteRawInteger<int32_t>(0);                  // data size (nop for now)
-			WriteRawInteger<uint32_t>(dimensions.size()); // ndim
-			WriteRawInteger<uint32_t>(1);                 // has nulls
-			WriteRawInteger<uint32_t>(value_oid);         // value_oid
-			// write the dimensions of the arrays
-			for (auto &dim : dimensions) {
-				WriteRawInteger<uint32_t>(dim); // array length
-				WriteRawInteger<uint32_t>(1);   // index lower bounds
-			}
-			// now recursively write the actual values
-			WriteArray(col, r, dimensions, 0, 1);
-
-			// after writing all list elements update the field size
-			auto end_position = stream.GetPosition();
-			auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
-			Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+		case LogicalTypeId::LIST:
+			WriteList(col, r, nullptr);
 			break;
-		}
-		case LogicalTypeId::STRUCT: {
-			auto &child_entries = StructVector::GetEntries(col);
-
-			auto start_position = stream.GetPosition();
-			WriteRawInteger<int32_t>(0);                     // data size (nop for now)
-			WriteRawInteger<uint32_t>(child_entries.size()); // column count
-			for (auto &child : child_entries) {
-				auto value_oid = PostgresUtils::ToPostgresOid(child->GetType());
-				WriteRawInteger<uint32_t>(value_oid); // value oid
-				WriteValue(*child, r);
-			}
-			auto end_position = stream.GetPosition();
-			// after writing all list elements update the field size
-			auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
-			Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+		case LogicalTypeId::STRUCT:
+			WriteStruct(col, r, nullptr);
 			break;
-		}
 		default:
 			throw NotImplementedException("Type \"%s\" is not supported for Postgres binary copy", type);
 		}
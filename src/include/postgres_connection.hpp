@@ -53,18 +53,31 @@ public:
 	vector<unique_ptr<PostgresResult>> ExecuteQueries(const string &queries);
 
 	PostgresVersion GetPostgresVersion();
+	//! The number of rows Postgres estimates a SELECT query to return, or 0 if no estimate is available
+	idx_t EstimateRows(const string &query);
 
 	vector<IndexInfo> GetIndexInfo(const string &table_name);
 
 	void BeginCopyTo(ClientContext &context, PostgresCopyState &state, PostgresCopyFormat format,
 	                 const string &schema_name, const string &table_name, const vector<string> &column_names);
 	void CopyData(data_ptr_t buffer, idx_t size);
-	void CopyData(PostgresBinaryWriter &writer);
-	void CopyData(PostgresTextWriter &writer);
+	void CopyData(PostgresCopyState &state, data_ptr_t buffer, idx_t size);
+	void CopyData(PostgresCopyState &state, PostgresBinaryWriter &writer);
+	void CopyData(PostgresCopyState &state, PostgresTextWriter &writer);
 	void CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk, DataChunk &varchar_chunk);
 	void FinishCopyTo(PostgresCopyState &state);
 
 	void BeginCopyFrom(const string &query, ExecStatusType expected_result);
+	//! Receive the next message of a COPY ... TO STDOUT - returns false once the COPY has finished.
+	//! Messages are read directly from the input buffer of the connection when possible - in that case "owned" is
+	//! false and the message is only valid until the next message is received. Otherwise it must be freed with
+	//! PQfreemem.
+	bool GetCopyData(char *&buffer, idx_t &length, bool &owned);
+	//! Return the next CopyData message only if it has already been received entirely - this does not read from
+	//! the connection, so previously returned in-place messages remain valid
+	bool GetBufferedCopyData(char *&buffer, idx_t &length);
+	//! Consume the results that follow a finished COPY ... TO STDOUT
+	void FinishCopyFrom();
 
 	bool IsOpen();
 	void Close();
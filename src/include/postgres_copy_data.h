@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_data.h
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <libpq-fe.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Fetch the next CopyData message of a COPY OUT without copying it out of the input buffer of the connection.
+//! Returns the length of the message and points buffer to it. The message is only valid until more data is read
+//! from the connection. If read_more is set, blocks until the message has been received.
+//! Returns 0 if the next message must be fetched through PQgetCopyData instead (e.g. CopyDone or errors),
+//! -1 if read_more is not set and no complete message is buffered, and -2 on failure.
+//! Always returns 0 for versions of libpq whose internal layout has not been verified.
+int PostgresGetCopyDataInPlace(PGconn *conn, const char **buffer, int read_more);
+
+#ifdef __cplusplus
+}
+#endif
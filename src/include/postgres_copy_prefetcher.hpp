@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_prefetcher.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/allocator.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/types/vector_buffer.hpp"
+
+#include <condition_variable>
+
+namespace duckdb {
+class PostgresConnection;
+
+//! A batch of CopyData messages received from Postgres, each message is prefixed by its length
+struct PostgresCopyBuffer {
+	explicit PostgresCopyBuffer(idx_t capacity);
+
+	AllocatedData data;
+	idx_t size = 0;
+	//! Whether or not this is the last buffer of a COPY
+	bool end_of_copy = false;
+
+public:
+	bool HasSpace(idx_t message_len) const;
+	void Append(const char *message, idx_t message_len);
+	void Reset();
+};
+
+//! Keeps a PostgresCopyBuffer alive while vectors reference strings stored in it
+class PostgresCopyVectorBuffer : public VectorBuffer {
+public:
+	explicit PostgresCopyVectorBuffer(shared_ptr<PostgresCopyBuffer> buffer_p)
+	    : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), buffer(std::move(buffer_p)) {
+	}
+
+private:
+	shared_ptr<PostgresCopyBuffer> buffer;
+};
+
+//! Receives the results of one or more COPY ... TO STDOUT queries on a background thread, so that the data of a
+//! COPY is transferred from the network while the previously received data is being decoded
+class PostgresCopyPrefetcher {
+public:
+	static constexpr const idx_t BUFFER_SIZE = 1024ULL * 1024ULL;
+	static constexpr const idx_t MAX_FILLED_BUFFERS = 4;
+
+public:
+	explicit PostgresCopyPrefetcher(PostgresConnection &con);
+	~PostgresCopyPrefetcher();
+
+	//! Queue a COPY query - queued queries are executed in order once the previous COPY has been received entirely
+	void EnqueueCopy(const string &sql);
+	//! Fetch the next filled buffer, blocks until one is available
+	shared_ptr<PostgresCopyBuffer> NextBuffer();
+	//! Return a buffer that has been read entirely so it can be re-used - buffers that are still referenced by
+	//! vectors are not re-used
+	void ReturnBuffer(shared_ptr<PostgresCopyBuffer> buffer);
+
+private:
+	void Run();
+	void FetchCopy(const string &sql);
+	shared_ptr<PostgresCopyBuffer> GetFreeBuffer();
+	bool PushBuffer(shared_ptr<PostgresCopyBuffer> buffer);
+
+private:
+	PostgresConnection &con;
+	mutex lock;
+	std::condition_variable buffer_available;
+	std::condition_variable space_available;
+	std::condition_variable copy_available;
+	deque<string> pending_copies;
+	deque<shared_ptr<PostgresCopyBuffer>> filled_buffers;
+	vector<shared_ptr<PostgresCopyBuffer>> free_buffers;
+	ErrorData error;
+	bool shutdown = false;
+	thread prefetch_thread;
+};
+
+} // namespace duckdb
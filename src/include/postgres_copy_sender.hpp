@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_sender.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/allocator.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/thread.hpp"
+
+#include <condition_variable>
+
+namespace duckdb {
+class PostgresConnection;
+
+//! A frame of COPY data - the data of multiple chunks coalesced into a single CopyData message
+struct PostgresCopyFrame {
+	explicit PostgresCopyFrame(idx_t capacity);
+
+	AllocatedData data;
+	idx_t size = 0;
+
+public:
+	void Append(const_data_ptr_t buffer, idx_t len);
+};
+
+//! Sends the data of a COPY ... FROM STDIN on a background thread. Data is coalesced into large frames which are
+//! written over the connection by the sender thread, so that the next chunks are produced while the previous frame
+//! is being transferred. At most MAX_PENDING_FRAMES frames are queued - producers block once these are full.
+//! While the COPY is in progress the connection is only used by the sender thread.
+class PostgresCopySender {
+public:
+	static constexpr const idx_t FRAME_SIZE = 4ULL * 1024ULL * 1024ULL;
+	static constexpr const idx_t MAX_PENDING_FRAMES = 2;
+
+public:
+	explicit PostgresCopySender(PostgresConnection &con);
+	~PostgresCopySender();
+
+	//! Append data to the COPY
+	void Append(const_data_ptr_t buffer, idx_t len);
+	//! Send all remaining data - afterwards the connection can be used again
+	void Finish();
+
+private:
+	void Run();
+	void SendFrame(PostgresCopyFrame &frame);
+	void PushFrame();
+	void CheckError();
+
+private:
+	PostgresConnection &con;
+	mutex lock;
+	std::condition_variable frame_available;
+	std::condition_variable space_available;
+	deque<unique_ptr<PostgresCopyFrame>> pending_frames;
+	vector<unique_ptr<PostgresCopyFrame>> free_frames;
+	//! The frame that is currently being filled - only accessed by the producer
+	unique_ptr<PostgresCopyFrame> current_frame;
+	ErrorData error;
+	bool finished = false;
+	bool shutdown = false;
+	thread sender_thread;
+};
+
+} // namespace duckdb
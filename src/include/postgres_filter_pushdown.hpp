@@ -11,21 +11,54 @@
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/planner/filter/conjunction_filter.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/dynamic_filter.hpp"
+#include "duckdb/planner/filter/in_filter.hpp"
+#include "duckdb/planner/expression.hpp"
+#include "postgres_utils.hpp"
 
 namespace duckdb {
 
+//! A column that can be referenced by an expression that is pushed into Postgres
+struct PostgresFilterColumn {
+	PostgresFilterColumn(string name_p, PostgresType postgres_type_p)
+	    : name(std::move(name_p)), postgres_type(std::move(postgres_type_p)) {
+	}
+
+	//! The (quoted) name of the column - empty if the column cannot be referenced
+	string name;
+	PostgresType postgres_type;
+};
+
 class PostgresFilterPushdown {
 public:
+	//! Transform the table filters into a Postgres predicate - the scan only accepts filters that can be evaluated by
+	//! Postgres, so failing to transform a filter is an internal error
 	static string TransformFilters(const vector<column_t> &column_ids, optional_ptr<TableFilterSet> filters,
-	                               const vector<string> &names);
+	                               const vector<string> &names, const vector<PostgresType> &postgres_types);
+	//! Transform the table filters into a Postgres predicate - returns false if a filter cannot be evaluated by
+	//! Postgres (filters that only prune rows, such as optional and dynamic filters, are skipped instead)
+	static bool TryTransformFilters(const vector<column_t> &column_ids, optional_ptr<TableFilterSet> filters,
+	                                const vector<string> &names, const vector<PostgresType> &postgres_types,
+	                                string &result);
+	//! Whether or not any of the filters is a dynamic filter - i.e. a filter that changes while the scan runs
+	static bool HasDynamicFilters(optional_ptr<TableFilterSet> filters);
+	//! Transform a boolean expression into an equivalent Postgres predicate - returns an empty string if the
+	//! expression cannot be evaluated by Postgres with the same result. Column references are resolved by their
+	//! binding (or reference) index into the columns.
+	static string TransformExpression(const Expression &expr, const vector<PostgresFilterColumn> &columns);
 
 private:
 	static string TransformCTIDLiteral(const Value &val);
 	static string TransformConstantFilter(string &column_name, ConstantFilter &filter, column_t column_id);
-	static string TransformFilter(string &column_name, TableFilter &filter, column_t column_id);
+	//! Returns false if the filter cannot be transformed - an empty result means the filter does not remove any rows
+	static bool TryTransformFilter(string &column_name, TableFilter &filter, column_t column_id,
+	                               const PostgresType &postgres_type, string &result);
+	static string TransformDynamicFilter(string &column_name, DynamicFilter &filter, column_t column_id);
+	static string TransformInFilter(string &column_name, InFilter &filter, column_t column_id);
+	static bool HasDynamicFilter(TableFilter &filter);
 	static string TransformComparison(ExpressionType type);
-	static string CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters, string op,
-	                               column_t column_id);
+	static bool CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters, string op,
+	                             column_t column_id, const PostgresType &postgres_type, string &result);
 };
 
 } // namespace duckdb
@@ -0,0 +1,28 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_partitioning.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Generates disjoint predicates that split a scan into partitions that can be read in parallel
+class PostgresPartitioning {
+public:
+	//! Split on the given (sorted, distinct) boundaries - boundaries are SQL literals. Produces one more partition
+	//! than there are boundaries. NULL values are placed in the first partition.
+	static vector<string> RangePartitions(const string &column_name, const vector<string> &boundaries);
+	//! Split the integer range [min, max] into (at most) partition_count equally sized ranges
+	static vector<string> IntegerRangePartitions(const string &column_name, int64_t min, int64_t max,
+	                                             idx_t partition_count);
+	//! Split on the hash of the column value
+	static vector<string> HashPartitions(const string &column_name, idx_t partition_count);
+};
+
+} // namespace duckdb
@@ -33,6 +33,10 @@ struct PostgresResultReader {
 public:
 	virtual void BeginCopy(const string &sql) = 0;
 	virtual PostgresReadResult Read(DataChunk &result) = 0;
+	//! Whether or not BeginCopy can be called for the next COPY while the current one is still being read
+	virtual bool SupportsPrefetch() const {
+		return false;
+	}
 
 protected:
 	PostgresConnection &con;
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_scan_materializer.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/thread.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+
+#include <condition_variable>
+#include <functional>
+
+namespace duckdb {
+class PostgresTransaction;
+
+//! Materializes a scan in its entirety on a background thread. The scanned rows are stored in buffer-managed
+//! collections (which can be spilled to disk), and are handed to the consumer as soon as they have been read.
+class PostgresScanMaterializer {
+public:
+	//! The function that scans the next chunk - the scan is exhausted once it returns an empty chunk
+	using scan_function_t = std::function<void(ClientContext &context, DataChunk &output)>;
+
+	//! The number of rows of the first segment - segments double in size up to MAX_SEGMENT_ROWS
+	static constexpr const idx_t INITIAL_SEGMENT_ROWS = STANDARD_VECTOR_SIZE;
+	static constexpr const idx_t MAX_SEGMENT_ROWS = 128ULL * STANDARD_VECTOR_SIZE;
+
+public:
+	//! If a transaction is provided the scan reads over the connection of the transaction - any other statement sent
+	//! over the connection waits until the materialization has finished. The background thread keeps the client
+	//! context alive, and is joined when the materializer is destroyed.
+	PostgresScanMaterializer(ClientContext &context, vector<LogicalType> types, scan_function_t scan_function,
+	                         optional_ptr<PostgresTransaction> transaction);
+	~PostgresScanMaterializer();
+
+	//! Fetch the next materialized chunk, blocks until one is available - returns an empty chunk once exhausted
+	void Scan(DataChunk &output);
+
+private:
+	void Run();
+	void Materialize();
+	void PushSegment(unique_ptr<ColumnDataCollection> segment);
+
+private:
+	//! The background thread only uses the context for the read-only accesses that the worker threads of the query
+	//! make as well (buffer manager, casts)
+	shared_ptr<ClientContext> context;
+	BufferManager &buffer_manager;
+	vector<LogicalType> types;
+	scan_function_t scan_function;
+	optional_ptr<PostgresTransaction> transaction;
+
+	mutex lock;
+	std::condition_variable segment_available;
+	//! Segments that have been materialized entirely but not yet scanned
+	deque<unique_ptr<ColumnDataCollection>> segments;
+	bool finished = false;
+	bool shutdown = false;
+	ErrorData error;
+	thread materialize_thread;
+
+	//! The segment that is currently being scanned - only accessed by the consumer
+	unique_ptr<ColumnDataCollection> current_segment;
+	ColumnDataScanState scan_state;
+};
+
+} // namespace duckdb
@@ -21,6 +21,7 @@ class PostgresTransaction;
 
 struct PostgresBindData : public FunctionData {
 	static constexpr const idx_t DEFAULT_PAGES_PER_TASK = 1000;
+	static constexpr const idx_t DEFAULT_TEXT_FETCH_SIZE = 10000;
 
 public:
 	PostgresBindData(ClientContext &context);
@@ -31,6 +32,31 @@ public:
 	string sql;
 	string limit;
 	idx_t pages_approx = 0;
+	//! The estimated number of rows returned by the scan (0 if unknown)
+	idx_t rows_approx = 0;
+	//! Predicates that split the scan into partitions - if set, every partition is scanned as a separate task
+	//! instead of splitting the scan by ctid
+	vector<string> partition_filters;
+	//! The integer column that the scan is split into range partitions on - the bounds of the ranges are only
+	//! fetched when the scan starts
+	string partition_range_column;
+	//! The number of range partitions (0 if the scan is not split into range partitions)
+	idx_t partition_range_count = 0;
+	//! Explicit bounds of the range partitions - NULL bounds are fetched from the result of the query
+	Value partition_range_min;
+	Value partition_range_max;
+	//! SQL expressions that are scanned instead of the columns - set when an aggregate is pushed into the scan
+	vector<string> column_expressions;
+	//! Filters on the rows of the table that are not table filters of the scan - i.e. expressions that have been
+	//! pushed into the scan, or the filters of a scan that an aggregate has been pushed into
+	string source_filter;
+	//! The GROUP BY clause of an aggregate that has been pushed into the scan
+	string group_by;
+	//! The ORDER BY clause of a Top-N that has been pushed into the scan
+	string order_by;
+	//! The number of rows after which no further tasks are started (0 if unlimited) - set when the LIMIT of a
+	//! parallel scan is pushed into every task
+	idx_t max_rows = 0;
 
 	vector<PostgresType> postgres_types;
 	vector<string> names;
@@ -45,11 +71,32 @@ public:
 	bool read_only = true;
 	bool emit_ctid = false;
 	bool use_transaction = true;
+	//! Whether the scan reads through the snapshot exported by the attached transaction on connections of its own,
+	//! rather than on the connection of the transaction
+	bool use_transaction_snapshot = false;
 	bool use_text_protocol = false;
+	bool use_prefetch = false;
+	//! The number of rows fetched at a time from a cursor when using the text protocol (0 to fetch all rows at once)
+	idx_t text_fetch_size = DEFAULT_TEXT_FETCH_SIZE;
 	idx_t max_threads = 1;
 
 public:
 	void SetTablePages(idx_t approx_num_pages);
+	void SetPartitions(vector<string> partition_filters);
+	void SetRangePartitions(const string &column_name, idx_t partition_count, Value min, Value max);
+	//! AND a filter to the source filter
+	void AddSourceFilter(const string &filter);
+	//! Try to read through the snapshot of the attached transaction - this allows scans of read-write transactions
+	//! to run in parallel, and to run alongside writes that use the connection of the transaction
+	bool TryUseTransactionSnapshot(ClientContext &context);
+	//! Whether or not the scan can be split into multiple tasks
+	bool HasTasks() const {
+		return pages_approx > 0 || HasPartitions();
+	}
+	//! Whether or not the scan is split into partitions
+	bool HasPartitions() const {
+		return !partition_filters.empty() || partition_range_count > 0;
+	}
 
 	void SetCatalog(PostgresCatalog &catalog);
 	void SetTable(PostgresTableEntry &table);
@@ -67,6 +114,9 @@ public:
 		return false;
 	}
 
+private:
+	void SetPartitionThreads(idx_t partition_count);
+
 private:
 	optional_ptr<PostgresCatalog> pg_catalog;
 	optional_ptr<PostgresTableEntry> pg_table;
@@ -25,6 +25,12 @@ public:
 
 private:
 	void Reset();
+	//! Replace the current result, and report the memory held by the new result to the buffer manager
+	void SetResult(unique_ptr<PostgresResult> new_result);
+	//! Declare a cursor for the query, returns false if the rows have to be fetched at once instead
+	bool TryDeclareCursor(const string &query);
+	//! Fetch the next batch of rows from the cursor, returns false if the cursor is exhausted
+	bool FetchNextBatch();
 	void ConvertVector(Vector &source, Vector &target, const PostgresType &postgres_type, idx_t count);
 	void ConvertList(Vector &source, Vector &target, const PostgresType &postgres_type, idx_t count);
 	void ConvertStruct(Vector &source, Vector &target, const PostgresType &postgres_type, idx_t count);
@@ -36,6 +42,13 @@ private:
 	DataChunk scan_chunk;
 	unique_ptr<PostgresResult> result;
 	idx_t row_offset = 0;
+	//! The memory held by the current result that has been reserved in the buffer manager
+	idx_t reserved_memory = 0;
+	//! The cursor the rows are fetched from, or empty if the rows are fetched at once
+	string cursor_name;
+	bool cursor_exhausted = true;
+	//! Whether or not the transaction the cursor lives in was started by the reader
+	bool cursor_transaction = false;
 };
 
 } // namespace duckdb
@@ -10,57 +10,88 @@
 
 #include "duckdb.hpp"
 #include "duckdb/common/types/interval.hpp"
-#include "duckdb/common/serializer/memory_stream.hpp"
+#include "duckdb/common/allocator.hpp"
+#include "duckdb/common/types/date.hpp"
+#include "duckdb/common/types/time.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 #include "postgres_conversion.hpp"
 
 namespace duckdb {
 
 class PostgresTextWriter {
+public:
+	static constexpr const idx_t INITIAL_CAPACITY = 16384;
+
 public:
 	explicit PostgresTextWriter(PostgresCopyState &state) : state(state) {
 	}
 
+	data_ptr_t GetData() {
+		return data.get();
+	}
+	idx_t GetSize() const {
+		return size;
+	}
+
+	//! Ensure that "len" more bytes can be written without resizing the buffer
+	void Reserve(idx_t len) {
+		if (size + len <= data.GetSize()) {
+			return;
+		}
+		idx_t min_capacity = INITIAL_CAPACITY;
+		auto new_data = Allocator::DefaultAllocator().Allocate(NextPowerOfTwo(MaxValue(size + len, min_capacity)));
+		if (size > 0) {
+			memcpy(new_data.get(), data.get(), size);
+		}
+		data = std::move(new_data);
+	}
+
+	void WriteRaw(const char *str, idx_t len) {
+		Reserve(len);
+		memcpy(data.get() + size, str, len);
+		size += len;
+	}
+
 	void WriteNull() {
-		stream.WriteData(const_data_ptr_cast("\b"), 1);
+		WriteCharInternal('\b');
 	}
 
 	void WriteCharInternal(char c) {
-		stream.WriteData(const_data_ptr_cast(&c), 1);
+		Reserve(1);
+		data.get()[size++] = data_t(c);
+	}
+
+	void WriteEscapedChar(char c) {
+		Reserve(2);
+		data.get()[size++] = '\\';
+		data.get()[size++] = data_t(c);
 	}
 
 	void WriteChar(char c) {
 		switch (c) {
 		case '\n':
-			WriteCharInternal('\\');
-			WriteCharInternal('n');
+			WriteEscapedChar('n');
 			break;
 		case '\r':
-			WriteCharInternal('\\');
-			WriteCharInternal('r');
+			WriteEscapedChar('r');
 			break;
 		case '\b':
-			WriteCharInternal('\\');
-			WriteCharInternal('b');
+			WriteEscapedChar('b');
 			break;
 		case '\f':
-			WriteCharInternal('\\');
-			WriteCharInternal('f');
+			WriteEscapedChar('f');
 			break;
 		case '\t':
-			WriteCharInternal('\\');
-			WriteCharInternal('t');
+			WriteEscapedChar('t');
 			break;
 		case '\v':
-			WriteCharInternal('\\');
-			WriteCharInternal('v');
+			WriteEscapedChar('v');
 			break;
 		case '\\':
-			WriteCharInternal('\\');
-			WriteCharInternal('\\');
+			WriteEscapedChar('\\');
 			break;
 		case '"':
-			WriteCharInternal('\\');
-			WriteCharInternal('"');
+			WriteEscapedChar('"');
 			break;
 		case '\0':
 			if (!state.has_null_byte_replacement) {
@@ -78,11 +109,182 @@ public:
 		}
 	}
 
+	//! Write a character that is nested "depth" levels deep within quoted array or composite elements - quotes and
+	//! backslashes are escaped once for every level
+	void WriteNestedChar(char c, idx_t depth) {
+		if (depth == 0) {
+			WriteChar(c);
+			return;
+		}
+		if (c == '"' || c == '\\') {
+			WriteNestedChar('\\', depth - 1);
+		}
+		WriteNestedChar(c, depth - 1);
+	}
+
+	static bool RequiresEscape(char c) {
+		return c == '\0' || (c >= '\b' && c <= '\r') || c == '\\' || c == '"';
+	}
+
+	//! Whether or not any of the 8 bytes might require escaping - i.e. is below 0x0E, a backslash or a quote
+	static bool MightRequireEscape(uint64_t word) {
+		constexpr uint64_t ONES = 0x0101010101010101ULL;
+		constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+		auto below = (word - ONES * 0x0E) & ~word;
+		auto backslash = word ^ (ONES * uint8_t('\\'));
+		auto quote = word ^ (ONES * uint8_t('"'));
+		auto has_backslash = (backslash - ONES) & ~backslash;
+		auto has_quote = (quote - ONES) & ~quote;
+		return ((below | has_backslash | has_quote) & HIGH_BITS) != 0;
+	}
+
+	//! Find the next character in [pos, len) that requires escaping - or len if there is none
+	static idx_t FindEscape(const char *str, idx_t pos, idx_t len) {
+		// skip over runs that require no escaping 8 bytes at a time
+		for (; pos + sizeof(uint64_t) <= len; pos += sizeof(uint64_t)) {
+			if (!MightRequireEscape(Load<uint64_t>(const_data_ptr_cast(str + pos)))) {
+				continue;
+			}
+			for (idx_t i = pos; i < pos + sizeof(uint64_t); i++) {
+				if (RequiresEscape(str[i])) {
+					return i;
+				}
+			}
+		}
+		for (; pos < len; pos++) {
+			if (RequiresEscape(str[pos])) {
+				return pos;
+			}
+		}
+		return len;
+	}
+
 	void WriteVarchar(string_t value) {
-		auto size = value.GetSize();
-		auto data = value.GetData();
-		for (idx_t c = 0; c < size; c++) {
-			WriteChar(data[c]);
+		auto len = value.GetSize();
+		auto str = value.GetData();
+		idx_t pos = 0;
+		while (pos < len) {
+			// copy the run of characters that require no escaping at once
+			auto next = FindEscape(str, pos, len);
+			WriteRaw(str + pos, next - pos);
+			if (next == len) {
+				break;
+			}
+			WriteChar(str[next]);
+			pos = next + 1;
+		}
+	}
+
+	void WriteNestedVarchar(string_t value, idx_t depth) {
+		if (depth == 0) {
+			WriteVarchar(value);
+			return;
+		}
+		auto len = value.GetSize();
+		auto str = value.GetData();
+		for (idx_t c = 0; c < len; c++) {
+			WriteNestedChar(str[c], depth);
+		}
+	}
+
+	template <class T>
+	void WriteUnsigned(T value) {
+		char buffer[32];
+		idx_t pos = sizeof(buffer);
+		do {
+			buffer[--pos] = char('0' + value % 10);
+			value /= 10;
+		} while (value > 0);
+		WriteRaw(buffer + pos, sizeof(buffer) - pos);
+	}
+
+	template <class T>
+	void WriteSigned(T value) {
+		using UNSIGNED = typename std::make_unsigned<T>::type;
+		if (value < 0) {
+			WriteCharInternal('-');
+			WriteUnsigned<UNSIGNED>(UNSIGNED(0) - UNSIGNED(value));
+		} else {
+			WriteUnsigned<UNSIGNED>(UNSIGNED(value));
+		}
+	}
+
+	//! Write an unsigned number padded with zeros to (at least) the given width
+	void WritePadded(uint64_t value, idx_t width) {
+		char buffer[32];
+		idx_t pos = sizeof(buffer);
+		do {
+			buffer[--pos] = char('0' + value % 10);
+			value /= 10;
+		} while (value > 0);
+		while (sizeof(buffer) - pos < width) {
+			buffer[--pos] = '0';
+		}
+		WriteRaw(buffer + pos, sizeof(buffer) - pos);
+	}
+
+	void WriteBoolean(bool value) {
+		WriteCharInternal(value ? 't' : 'f');
+	}
+
+	//! Writes the date without era - returns whether the date is BC
+	bool WriteDatePart(date_t value) {
+		int32_t year, month, day;
+		Date::Convert(value, year, month, day);
+		bool bc = year <= 0;
+		WritePadded(NumericCast<uint64_t>(bc ? 1 - year : year), 4);
+		WriteCharInternal('-');
+		WritePadded(NumericCast<uint64_t>(month), 2);
+		WriteCharInternal('-');
+		WritePadded(NumericCast<uint64_t>(day), 2);
+		return bc;
+	}
+
+	void WriteDate(date_t value) {
+		if (!Date::IsFinite(value)) {
+			WriteInfinity(value == date_t::infinity());
+			return;
+		}
+		if (WriteDatePart(value)) {
+			WriteRaw(" BC", 3);
+		}
+	}
+
+	void WriteTimestamp(timestamp_t value, bool with_time_zone) {
+		if (!Timestamp::IsFinite(value)) {
+			WriteInfinity(value == timestamp_t::infinity());
+			return;
+		}
+		date_t date;
+		dtime_t time;
+		Timestamp::Convert(value, date, time);
+		auto bc = WriteDatePart(date);
+		int32_t hour, minute, second, micros;
+		Time::Convert(time, hour, minute, second, micros);
+		WriteCharInternal(' ');
+		WritePadded(NumericCast<uint64_t>(hour), 2);
+		WriteCharInternal(':');
+		WritePadded(NumericCast<uint64_t>(minute), 2);
+		WriteCharInternal(':');
+		WritePadded(NumericCast<uint64_t>(second), 2);
+		if (micros > 0) {
+			WriteCharInternal('.');
+			WritePadded(NumericCast<uint64_t>(micros), 6);
+		}
+		if (with_time_zone) {
+			// timestamps with time zone are stored in UTC
+			WriteRaw("+00", 3);
+		}
+		if (bc) {
+			WriteRaw(" BC", 3);
+		}
+	}
+
+	void WriteInfinity(bool positive) {
+		if (positive) {
+			WriteRaw("infinity", 8);
+		} else {
+			WriteRaw("-infinity", 9);
 		}
 	}
 
@@ -98,20 +300,23 @@ public:
 	}
 
 	void WriteSeparator() {
-		stream.WriteData(const_data_ptr_cast("\t"), 1);
+		WriteCharInternal('\t');
 	}
 
 	void FinishRow() {
-		stream.WriteData(const_data_ptr_cast("\n"), 1);
+		WriteCharInternal('\n');
 	}
 
 	void WriteFooter() {
-		stream.WriteData(const_data_ptr_cast("\\.\n"), 3);
+		WriteRaw("\\.\n", 3);
 	}
 
 public:
-	MemoryStream stream;
 	PostgresCopyState &state;
+
+private:
+	AllocatedData data;
+	idx_t size = 0;
 };
 
 } // namespace duckdb
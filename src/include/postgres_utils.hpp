@@ -9,12 +9,14 @@
 #pragma once
 
 #include "duckdb.hpp"
+#include "duckdb/common/allocator.hpp"
 #include <libpq-fe.h>
 #include "postgres_version.hpp"
 
 namespace duckdb {
 class PostgresSchemaEntry;
 class PostgresTransaction;
+class PostgresCopySender;
 
 struct PostgresTypeData {
 	int64_t type_modifier = 0;
@@ -47,9 +49,20 @@ struct PostgresType {
 enum class PostgresCopyFormat { AUTO = 0, BINARY = 1, TEXT = 2 };
 
 struct PostgresCopyState {
+	PostgresCopyState();
+	~PostgresCopyState();
+
 	PostgresCopyFormat format = PostgresCopyFormat::AUTO;
 	bool has_null_byte_replacement = false;
 	string null_byte_replacement;
+	//! The buffer binary COPY data is encoded into - reused across chunks
+	AllocatedData encode_buffer;
+	//! Whether or not to send the data of the COPY on a background thread (pg_use_async_copy)
+	bool use_async_copy = false;
+	//! The sender of the active COPY - if use_async_copy is enabled
+	unique_ptr<PostgresCopySender> sender;
+	//! The Postgres types of the copied columns (if known) - used to binary encode annotated and nested types
+	vector<PostgresType> postgres_types;
 
 	void Initialize(ClientContext &context);
 };
@@ -66,6 +79,8 @@ public:
 	                                     PostgresType &postgres_type);
 	static string TypeToString(const LogicalType &input);
 	static string PostgresOidToName(uint32_t oid);
+	//! The oid of a built-in Postgres type by its name - or 0 if the type is not known
+	static uint32_t PostgresNameToOid(const string &name);
 	static uint32_t ToPostgresOid(const LogicalType &input);
 	static bool SupportedPostgresOid(const LogicalType &input);
 	static LogicalType RemoveAlias(const LogicalType &type);
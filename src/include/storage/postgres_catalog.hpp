@@ -17,6 +17,7 @@
 namespace duckdb {
 class PostgresCatalog;
 class PostgresSchemaEntry;
+class PostgresTransaction;
 
 class PostgresCatalog : public Catalog {
 public:
@@ -67,9 +68,10 @@ public:
 		return version;
 	}
 
-	//! Label all postgres scans in the sub-tree as requiring materialization
+	//! Label all postgres scans in the sub-tree as reading through the snapshot of their transaction, or as requiring
+	//! materialization if no snapshot can be exported
 	//! This is used for e.g. insert queries that have both (1) a scan from a postgres table, and (2) a sink into one
-	static void MaterializePostgresScans(PhysicalOperator &op);
+	static void MaterializePostgresScans(ClientContext &context, PhysicalOperator &op);
 	static bool IsPostgresScan(const string &name);
 
 	//! Whether or not this is an in-memory Postgres database
@@ -81,6 +83,8 @@ public:
 	}
 
 	void ClearCache();
+	//! Whether or not the server allows preparing transactions (i.e. max_prepared_transactions > 0)
+	bool SupportsPreparedTransactions(PostgresTransaction &transaction);
 
 	//! Whether or not this catalog should search a specific type with the standard priority
 	CatalogLookupBehavior CatalogTypeLookupRule(CatalogType type) const override {
@@ -104,6 +108,9 @@ private:
 	PostgresSchemaSet schemas;
 	PostgresConnectionPool connection_pool;
 	string default_schema;
+	mutex prepared_transactions_lock;
+	bool prepared_transactions_checked = false;
+	bool supports_prepared_transactions = false;
 };
 
 } // namespace duckdb
@@ -13,6 +13,11 @@
 
 namespace duckdb {
 
+//! How an INSERT writes to Postgres - DISABLED writes over the connection of the transaction, ATOMIC and BULK write
+//! over a connection per thread. ATOMIC prepares the transactions of these connections and commits them together
+//! with the transaction, BULK commits them as soon as the thread has finished writing.
+enum class PostgresParallelInsertMode { DISABLED, ATOMIC, BULK };
+
 class PostgresInsert : public PhysicalOperator {
 public:
 	//! INSERT INTO
@@ -32,6 +37,8 @@ public:
 	physical_index_vector_t<idx_t> column_index_map;
 	//! Whether or not we can keep the copy alive during Sink calls
 	bool keep_copy_alive = true;
+	//! Whether or not every thread writes over a connection of its own
+	PostgresParallelInsertMode parallel_insert = PostgresParallelInsertMode::DISABLED;
 
 public:
 	// Source interface
@@ -44,7 +51,9 @@ public:
 public:
 	// Sink interface
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
 	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
 	                          OperatorSinkFinalizeInput &input) const override;
 
@@ -53,9 +62,12 @@ public:
 	}
 
 	bool ParallelSink() const override {
-		return false;
+		return parallel_insert != PostgresParallelInsertMode::DISABLED;
 	}
 
+	//! Parse the pg_parallel_insert setting
+	static PostgresParallelInsertMode GetParallelInsertMode(const string &value);
+
 	string GetName() const override;
 	InsertionOrderPreservingMap<string> ParamsToString() const override;
 };
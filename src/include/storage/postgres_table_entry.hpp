@@ -13,6 +13,8 @@
 #include "postgres_utils.hpp"
 
 namespace duckdb {
+class PostgresTransaction;
+struct PostgresBindData;
 
 struct PostgresTableInfo {
 	PostgresTableInfo() {
@@ -36,6 +38,7 @@ struct PostgresTableInfo {
 	vector<PostgresType> postgres_types;
 	vector<string> postgres_names;
 	idx_t approx_num_pages = 0;
+	idx_t approx_num_rows = 0;
 };
 
 class PostgresTableEntry : public TableCatalogEntry {
@@ -55,6 +58,9 @@ public:
 
 	//! Get the copy format (text or binary) that should be used when writing data to this table
 	PostgresCopyFormat GetCopyFormat(ClientContext &context);
+	//! Get the key boundaries that split this table into ranges of (roughly) equal size, based on the histogram of
+	//! a single-column primary key or unique constraint. Returns false if there is no such key or no histogram.
+	bool GetKeyRanges(PostgresTransaction &transaction, string &key_column, vector<string> &boundaries);
 
 public:
 	//! Postgres type annotations
@@ -65,6 +71,24 @@ public:
 	vector<string> postgres_names;
 	//! The approximate number of pages a table consumes in Postgres
 	idx_t approx_num_pages;
+	//! The approximate number of rows in the table according to Postgres (0 if unknown)
+	idx_t approx_num_rows;
+
+private:
+	//! Split the scan on key ranges if the table cannot be scanned by ctid ranges
+	void PrepareKeyRangeScan(ClientContext &context, PostgresTransaction &transaction, PostgresBindData &bind_data);
+	//! Load the number of distinct values per column from pg_stats
+	void LoadStatistics(PostgresTransaction &transaction);
+
+private:
+	mutex key_range_lock;
+	bool key_ranges_loaded = false;
+	string key_range_column;
+	vector<string> key_range_boundaries;
+	mutex statistics_lock;
+	bool statistics_loaded = false;
+	//! The estimated number of distinct values per column (0 if unknown)
+	vector<idx_t> distinct_counts;
 };
 
 } // namespace duckdb
@@ -48,6 +48,7 @@ protected:
 	static void AddColumn(optional_ptr<PostgresTransaction> transaction, optional_ptr<PostgresSchemaEntry> schema,
 	                      PostgresResult &result, idx_t row, PostgresTableInfo &table_info);
 	static void AddConstraint(PostgresResult &result, idx_t row, PostgresTableInfo &table_info);
+	static idx_t GetApproxNumRows(PostgresResult &result, idx_t row);
 	static void AddColumnOrConstraint(optional_ptr<PostgresTransaction> transaction,
 	                                  optional_ptr<PostgresSchemaEntry> schema, PostgresResult &result, idx_t row,
 	                                  PostgresTableInfo &table_info);
@@ -8,10 +8,14 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/transaction/transaction.hpp"
 #include "postgres_connection.hpp"
 #include "storage/postgres_connection_pool.hpp"
 
+#include <condition_variable>
+
 namespace duckdb {
 class PostgresCatalog;
 class PostgresSchemaEntry;
@@ -41,18 +45,51 @@ public:
 	optional_ptr<CatalogEntry> ReferenceEntry(shared_ptr<CatalogEntry> &entry);
 
 	string GetTemporarySchema();
+	//! Returns a snapshot exported by the transaction that other connections can import to read the same data as
+	//! the transaction, or an empty string if no such snapshot can be exported - i.e. after the transaction has
+	//! written, as its own writes are not visible through an imported snapshot
+	string GetSnapshot();
+	//! Whether or not GetSnapshot might return a snapshot - this does not query Postgres, so it can be used while
+	//! planning. Scans that plan to read through the snapshot only export it when they start.
+	bool CanExportSnapshot();
+	//! Register a read over the connection of the transaction that runs on a background thread - other statements
+	//! sent over the connection wait until all background reads have ended
+	void BeginBackgroundRead();
+	void EndBackgroundRead();
+	//! Whether or not the transaction has written - i.e. has been assigned a transaction id
+	bool HasWritten();
+	//! Record that the transaction has written over other connections (e.g. a parallel insert)
+	void MarkWritten();
+	//! Register a prepared transaction that is committed or rolled back together with this transaction
+	void AddPreparedTransaction(const string &gid);
 
 private:
 	PostgresPoolConnection connection;
 	PostgresTransactionState transaction_state;
 	AccessMode access_mode;
 	PostgresIsolationLevel isolation_level;
+	PostgresVersion version;
 	string temporary_schema;
+	mutex snapshot_lock;
+	//! The exported snapshot and the query it was exported or last validated for
+	string snapshot;
+	transaction_t snapshot_query = MAXIMUM_QUERY_ID;
+	bool snapshot_unavailable = false;
+	mutex background_read_lock;
+	std::condition_variable background_reads_finished;
+	idx_t active_background_reads = 0;
+	mutex prepared_lock;
+	vector<string> prepared_transactions;
+	//! Whether or not the transaction has written over other connections
+	atomic<bool> written_elsewhere {false};
 	reference_map_t<CatalogEntry, shared_ptr<CatalogEntry>> referenced_entries;
 
 private:
 	//! Retrieves the connection **without** starting a transaction if none is active
 	PostgresConnection &GetConnectionRaw();
+	//! Wait until the background reads over the connection have ended - required before sending a statement
+	void WaitForBackgroundReads();
+	void RollbackPreparedTransactions();
 
 	string GetBeginTransactionQuery();
 };
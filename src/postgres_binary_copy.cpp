@@ -1,5 +1,6 @@
 #include "postgres_binary_copy.hpp"
 #include "postgres_binary_writer.hpp"
+#include "postgres_binary_encoder.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/common/file_system.hpp"
 
@@ -30,17 +31,9 @@ struct PostgresBinaryCopyGlobalState : public GlobalFunctionData {
 	}
 
 	void WriteChunk(DataChunk &chunk) {
-		chunk.Flatten();
-		PostgresBinaryWriter writer(copy_state);
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			writer.BeginRow(chunk.ColumnCount());
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				auto &col = chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
-		Flush(writer);
+		PostgresBinaryEncoder encoder(copy_state);
+		encoder.Encode(chunk);
+		file_writer->WriteData(encoder.GetData(), encoder.GetSize());
 	}
 
 	void Flush() {
@@ -0,0 +1,398 @@
+#include "postgres_binary_encoder.hpp"
+#include "postgres_binary_writer.hpp"
+
+namespace duckdb {
+
+PostgresEncoderColumn::PostgresEncoderColumn() = default;
+PostgresEncoderColumn::~PostgresEncoderColumn() = default;
+PostgresEncoderColumn::PostgresEncoderColumn(PostgresEncoderColumn &&other) noexcept = default;
+
+PostgresBinaryEncoder::PostgresBinaryEncoder(PostgresCopyState &state) : state(state) {
+}
+
+//! The size of a non-NULL field of a fixed-width type (including the length prefix) - or 0 for other types
+static idx_t GetFixedFieldSize(const LogicalType &type) {
+	idx_t width;
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		width = sizeof(uint8_t);
+		break;
+	case LogicalTypeId::SMALLINT:
+		width = sizeof(uint16_t);
+		break;
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DATE:
+		width = sizeof(uint32_t);
+		break;
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		width = sizeof(uint64_t);
+		break;
+	case LogicalTypeId::TIME_TZ:
+		width = sizeof(uint64_t) + sizeof(int32_t);
+		break;
+	case LogicalTypeId::INTERVAL:
+	case LogicalTypeId::UUID:
+		width = 2 * sizeof(uint64_t);
+		break;
+	default:
+		return 0;
+	}
+	return sizeof(int32_t) + width;
+}
+
+void PostgresBinaryEncoder::Encode(DataChunk &chunk) {
+	chunk.Flatten();
+	auto count = chunk.size();
+	columns.clear();
+	columns.resize(chunk.ColumnCount());
+	// compute the encoded size of every row - starting with the field count
+	row_positions.assign(count, sizeof(int16_t));
+	for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+		ComputeSizes(c, chunk.data[c], count);
+	}
+	// convert the sizes into the position of every row in the buffer
+	size = 0;
+	for (idx_t r = 0; r < count; r++) {
+		auto row_size = row_positions[r];
+		row_positions[r] = size;
+		size += row_size;
+	}
+	if (state.encode_buffer.GetSize() < size) {
+		state.encode_buffer = Allocator::DefaultAllocator().Allocate(NextPowerOfTwo(size));
+	}
+	auto buffer = GetData();
+	auto field_count = PostgresBinaryWriter::GetInteger<int16_t>(NumericCast<int16_t>(chunk.ColumnCount()));
+	for (idx_t r = 0; r < count; r++) {
+		Store<int16_t>(field_count, buffer + row_positions[r]);
+		row_positions[r] += sizeof(int16_t);
+	}
+	for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+		WriteColumn(c, chunk.data[c], count);
+	}
+}
+
+optional_ptr<const PostgresType> PostgresBinaryEncoder::GetPostgresType(idx_t column_idx) const {
+	if (state.postgres_types.size() != columns.size()) {
+		// the Postgres types of the columns are not known
+		return nullptr;
+	}
+	return &state.postgres_types[column_idx];
+}
+
+//! Whether or not values of the column are encoded in the same way as the DuckDB type - annotated types such as
+//! jsonb or the geometric types have a different representation in Postgres
+static bool UsesDuckDBEncoding(optional_ptr<const PostgresType> pg_type) {
+	if (!pg_type) {
+		return true;
+	}
+	switch (pg_type->info) {
+	case PostgresTypeAnnotation::STANDARD:
+	case PostgresTypeAnnotation::FIXED_LENGTH_CHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void PostgresBinaryEncoder::ComputeSizes(idx_t column_idx, Vector &col, idx_t count) {
+	auto &type = col.GetType();
+	auto &validity = FlatVector::Validity(col);
+	auto pg_type = GetPostgresType(column_idx);
+	auto &column = columns[column_idx];
+	if (!UsesDuckDBEncoding(pg_type)) {
+		EncodeRows(column, col, count, pg_type);
+		return;
+	}
+	auto fixed_size = GetFixedFieldSize(type);
+	if (fixed_size > 0) {
+		if (validity.AllValid()) {
+			for (idx_t r = 0; r < count; r++) {
+				row_positions[r] += fixed_size;
+			}
+		} else {
+			for (idx_t r = 0; r < count; r++) {
+				row_positions[r] += validity.RowIsValid(r) ? fixed_size : sizeof(int32_t);
+			}
+		}
+		return;
+	}
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB: {
+		auto data = FlatVector::GetData<string_t>(col);
+		bool check_null_bytes = type.id() == LogicalTypeId::VARCHAR;
+		auto replacement_size = state.null_byte_replacement.size();
+		for (idx_t r = 0; r < count; r++) {
+			if (!validity.RowIsValid(r)) {
+				row_positions[r] += sizeof(int32_t);
+				continue;
+			}
+			auto str_size = data[r].GetSize();
+			auto str_data = data[r].GetData();
+			idx_t encoded_size = str_size;
+			if (check_null_bytes && memchr(str_data, '\0', str_size) != nullptr) {
+				if (!state.has_null_byte_replacement) {
+					PostgresBinaryWriter::ThrowNullByteException();
+				}
+				column.replace_null_bytes = true;
+				for (idx_t i = 0; i < str_size; i++) {
+					if (str_data[i] == '\0') {
+						encoded_size += replacement_size - 1;
+					}
+				}
+			}
+			row_positions[r] += sizeof(int32_t) + encoded_size;
+		}
+		break;
+	}
+	default:
+		// no specialized kernel - encode the values of the column a row at a time
+		EncodeRows(column, col, count, pg_type);
+		break;
+	}
+}
+
+void PostgresBinaryEncoder::EncodeRows(PostgresEncoderColumn &column, Vector &col, idx_t count,
+                                       optional_ptr<const PostgresType> pg_type) {
+	column.writer = make_uniq<PostgresBinaryWriter>(state);
+	column.offsets.resize(count + 1);
+	auto &stream = column.writer->stream;
+	for (idx_t r = 0; r < count; r++) {
+		column.offsets[r] = stream.GetPosition();
+		if (pg_type) {
+			column.writer->WriteValue(col, r, *pg_type);
+		} else {
+			column.writer->WriteValue(col, r);
+		}
+	}
+	column.offsets[count] = stream.GetPosition();
+	for (idx_t r = 0; r < count; r++) {
+		row_positions[r] += column.offsets[r + 1] - column.offsets[r];
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Kernels
+//===--------------------------------------------------------------------===//
+struct EncodeCast {
+	template <class SRC, class DST>
+	static DST Operation(SRC value) {
+		return static_cast<DST>(value);
+	}
+};
+
+struct EncodeFloat {
+	template <class SRC, class DST>
+	static DST Operation(SRC value) {
+		return Load<DST>(const_data_ptr_cast(&value));
+	}
+};
+
+struct EncodeDate {
+	template <class SRC, class DST>
+	static DST Operation(SRC value) {
+		return PostgresBinaryWriter::DuckDBDateToPostgres(value);
+	}
+};
+
+struct EncodeTime {
+	template <class SRC, class DST>
+	static DST Operation(SRC value) {
+		return static_cast<DST>(value.micros);
+	}
+};
+
+struct EncodeTimestamp {
+	template <class SRC, class DST>
+	static DST Operation(SRC value) {
+		return PostgresBinaryWriter::DuckDBTimestampToPostgres(value);
+	}
+};
+
+static inline void WriteNullField(data_ptr_t buffer, idx_t &position) {
+	Store<int32_t>(PostgresBinaryWriter::GetInteger<int32_t>(-1), buffer + position);
+	position += sizeof(int32_t);
+}
+
+template <class SRC, class DST, class OP>
+static void WriteFixedColumn(Vector &col, idx_t count, data_ptr_t buffer, idx_t *positions) {
+	auto data = FlatVector::GetData<SRC>(col);
+	auto &validity = FlatVector::Validity(col);
+	auto all_valid = validity.AllValid();
+	const auto length = PostgresBinaryWriter::GetInteger<int32_t>(sizeof(DST));
+	DST encoded[STANDARD_VECTOR_SIZE];
+	for (idx_t base = 0; base < count; base += STANDARD_VECTOR_SIZE) {
+		auto batch_count = MinValue<idx_t>(count - base, STANDARD_VECTOR_SIZE);
+		// convert and byte-swap the values first - this loop has no dependencies between rows and is vectorized
+		if (all_valid) {
+			for (idx_t i = 0; i < batch_count; i++) {
+				encoded[i] = PostgresBinaryWriter::GetInteger<DST>(OP::template Operation<SRC, DST>(data[base + i]));
+			}
+		} else {
+			for (idx_t i = 0; i < batch_count; i++) {
+				// the conversion can throw - do not convert the (undefined) values of NULL rows
+				encoded[i] = validity.RowIsValid(base + i) ? PostgresBinaryWriter::GetInteger<DST>(
+				                                                 OP::template Operation<SRC, DST>(data[base + i]))
+				                                           : DST(0);
+			}
+		}
+		// scatter the encoded values to the rows
+		for (idx_t i = 0; i < batch_count; i++) {
+			auto &position = positions[base + i];
+			if (!all_valid && !validity.RowIsValid(base + i)) {
+				WriteNullField(buffer, position);
+				continue;
+			}
+			Store<int32_t>(length, buffer + position);
+			Store<DST>(encoded[i], buffer + position + sizeof(int32_t));
+			position += sizeof(int32_t) + sizeof(DST);
+		}
+	}
+}
+
+struct EncodeTimeTZ {
+	static void Operation(dtime_tz_t value, data_ptr_t target) {
+		Store<uint64_t>(PostgresBinaryWriter::GetInteger<uint64_t>(value.time().micros), target);
+		Store<int32_t>(PostgresBinaryWriter::GetInteger<int32_t>(-value.offset()), target + sizeof(uint64_t));
+	}
+};
+
+struct EncodeInterval {
+	static void Operation(interval_t value, data_ptr_t target) {
+		Store<uint64_t>(PostgresBinaryWriter::GetInteger<uint64_t>(value.micros), target);
+		Store<uint32_t>(PostgresBinaryWriter::GetInteger<uint32_t>(value.days), target + sizeof(uint64_t));
+		Store<uint32_t>(PostgresBinaryWriter::GetInteger<uint32_t>(value.months),
+		                target + sizeof(uint64_t) + sizeof(uint32_t));
+	}
+};
+
+struct EncodeUUID {
+	static void Operation(hugeint_t value, data_ptr_t target) {
+		Store<uint64_t>(PostgresBinaryWriter::GetInteger<uint64_t>(value.upper ^ uint64_t(1) << 63), target);
+		Store<uint64_t>(PostgresBinaryWriter::GetInteger<uint64_t>(value.lower), target + sizeof(uint64_t));
+	}
+};
+
+template <class T, class OP>
+static void WriteCompositeColumn(Vector &col, idx_t count, idx_t width, data_ptr_t buffer, idx_t *positions) {
+	auto data = FlatVector::GetData<T>(col);
+	auto &validity = FlatVector::Validity(col);
+	const auto length = PostgresBinaryWriter::GetInteger<int32_t>(NumericCast<int32_t>(width));
+	for (idx_t r = 0; r < count; r++) {
+		auto &position = positions[r];
+		if (!validity.RowIsValid(r)) {
+			WriteNullField(buffer, position);
+			continue;
+		}
+		Store<int32_t>(length, buffer + position);
+		OP::Operation(data[r], buffer + position + sizeof(int32_t));
+		position += sizeof(int32_t) + width;
+	}
+}
+
+static void WriteStringColumn(Vector &col, idx_t count, data_ptr_t buffer, idx_t *positions,
+                              optional_ptr<const string> null_byte_replacement) {
+	auto data = FlatVector::GetData<string_t>(col);
+	auto &validity = FlatVector::Validity(col);
+	for (idx_t r = 0; r < count; r++) {
+		auto &position = positions[r];
+		if (!validity.RowIsValid(r)) {
+			WriteNullField(buffer, position);
+			continue;
+		}
+		auto str_size = data[r].GetSize();
+		auto str_data = data[r].GetData();
+		auto length_position = position;
+		position += sizeof(int32_t);
+		if (!null_byte_replacement) {
+			memcpy(buffer + position, str_data, str_size);
+			position += str_size;
+		} else {
+			for (idx_t i = 0; i < str_size; i++) {
+				if (str_data[i] == '\0') {
+					memcpy(buffer + position, null_byte_replacement->data(), null_byte_replacement->size());
+					position += null_byte_replacement->size();
+				} else {
+					buffer[position++] = data_t(str_data[i]);
+				}
+			}
+		}
+		auto field_size = NumericCast<int32_t>(position - length_position - sizeof(int32_t));
+		Store<int32_t>(PostgresBinaryWriter::GetInteger<int32_t>(field_size), buffer + length_position);
+	}
+}
+
+void PostgresBinaryEncoder::WriteColumn(idx_t column_idx, Vector &col, idx_t count) {
+	auto buffer = GetData();
+	auto positions = row_positions.data();
+	auto &column = columns[column_idx];
+	if (column.writer) {
+		// the column has been encoded already - copy the encoded fields to the rows
+		auto encoded = column.writer->stream.GetData();
+		for (idx_t r = 0; r < count; r++) {
+			auto field_size = column.offsets[r + 1] - column.offsets[r];
+			memcpy(buffer + positions[r], encoded + column.offsets[r], field_size);
+			positions[r] += field_size;
+		}
+		return;
+	}
+	auto &type = col.GetType();
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		WriteFixedColumn<bool, uint8_t, EncodeCast>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::SMALLINT:
+		WriteFixedColumn<int16_t, uint16_t, EncodeCast>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::INTEGER:
+		WriteFixedColumn<int32_t, uint32_t, EncodeCast>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::BIGINT:
+		WriteFixedColumn<int64_t, uint64_t, EncodeCast>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::FLOAT:
+		WriteFixedColumn<float, uint32_t, EncodeFloat>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::DOUBLE:
+		WriteFixedColumn<double, uint64_t, EncodeFloat>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::DATE:
+		WriteFixedColumn<date_t, uint32_t, EncodeDate>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::TIME:
+		WriteFixedColumn<dtime_t, uint64_t, EncodeTime>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+		WriteFixedColumn<timestamp_t, uint64_t, EncodeTimestamp>(col, count, buffer, positions);
+		break;
+	case LogicalTypeId::TIME_TZ:
+		WriteCompositeColumn<dtime_tz_t, EncodeTimeTZ>(col, count, sizeof(uint64_t) + sizeof(int32_t), buffer,
+		                                               positions);
+		break;
+	case LogicalTypeId::INTERVAL:
+		WriteCompositeColumn<interval_t, EncodeInterval>(col, count, 2 * sizeof(uint64_t), buffer, positions);
+		break;
+	case LogicalTypeId::UUID:
+		WriteCompositeColumn<hugeint_t, EncodeUUID>(col, count, 2 * sizeof(uint64_t), buffer, positions);
+		break;
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB: {
+		optional_ptr<const string> replacement;
+		if (column.replace_null_bytes) {
+			replacement = &state.null_byte_replacement;
+		}
+		WriteStringColumn(col, count, buffer, positions, replacement);
+		break;
+	}
+	default:
+		throw InternalException("Unsupported type \"%s\" for the binary encoder", type);
+	}
+}
+
+} // namespace duckdb
@@ -139,6 +139,29 @@ PostgresVersion PostgresConnection::GetPostgresVersion() {
 	return version;
 }
 
+idx_t PostgresConnection::EstimateRows(const string &query) {
+	// only explain plain queries - a failing EXPLAIN would abort the transaction
+	auto query_start = query.substr(0, 64);
+	StringUtil::LTrim(query_start);
+	query_start = StringUtil::Lower(query_start);
+	if (!StringUtil::StartsWith(query_start, "select") && !StringUtil::StartsWith(query_start, "with") &&
+	    !StringUtil::StartsWith(query_start, "values")) {
+		return 0;
+	}
+	auto result = TryQuery("EXPLAIN (FORMAT JSON) " + query);
+	if (!result || result->Count() == 0 || result->IsNull(0, 0)) {
+		return 0;
+	}
+	// the estimate of the top-level node is the first "Plan Rows" entry in the plan
+	auto plan = result->GetString(0, 0);
+	const string plan_rows = "\"Plan Rows\":";
+	auto pos = plan.find(plan_rows);
+	if (pos == string::npos) {
+		return 0;
+	}
+	return strtoull(plan.c_str() + pos + plan_rows.size(), nullptr, 10);
+}
+
 bool PostgresConnection::IsOpen() {
 	return connection.get();
 }
@@ -0,0 +1,73 @@
+/*
+ * Direct access to the CopyData messages buffered by libpq
+ *
+ * PQgetCopyData allocates and copies every message it returns. Since libpq is compiled into the extension we can
+ * instead look at the input buffer of the connection and return messages in-place.
+ */
+#include "postgres_fe.h"
+#include "libpq-int.h"
+#include "port/pg_bswap.h"
+
+#include "postgres_copy_data.h"
+
+/* length of the message type byte + the message length */
+#define COPY_DATA_HEADER_LENGTH 5
+
+/*
+ * The layout of PGconn is private to libpq - only look into the input buffer for the versions of libpq it has been
+ * verified against, and otherwise always let PQgetCopyData fetch the messages
+ */
+#if PG_VERSION_NUM >= 100000 && PG_VERSION_NUM < 180000
+#define POSTGRES_COPY_DATA_IN_PLACE
+#endif
+
+#ifndef POSTGRES_COPY_DATA_IN_PLACE
+int PostgresGetCopyDataInPlace(PGconn *conn, const char **buffer, int read_more) {
+	return 0;
+}
+#else
+int PostgresGetCopyDataInPlace(PGconn *conn, const char **buffer, int read_more) {
+	for (;;) {
+		int available;
+		int32 message_length;
+
+		if (conn->asyncStatus != PGASYNC_COPY_OUT || conn->Pfdebug) {
+			/* let libpq handle anything that is not a plain COPY OUT */
+			return 0;
+		}
+		available = conn->inEnd - conn->inStart;
+		if (available > 0 && conn->inBuffer[conn->inStart] != 'd') {
+			/* CopyDone, an error or a notice - let libpq handle it */
+			return 0;
+		}
+		if (available >= COPY_DATA_HEADER_LENGTH) {
+			memcpy(&message_length, conn->inBuffer + conn->inStart + 1, sizeof(int32));
+			message_length = pg_ntoh32(message_length);
+			if (message_length <= 4) {
+				/* empty (or corrupt) message - let libpq deal with it */
+				return 0;
+			}
+			if (available >= 1 + message_length) {
+				/* the message has been received entirely - return it in-place */
+				*buffer = conn->inBuffer + conn->inStart + COPY_DATA_HEADER_LENGTH;
+				conn->inStart += 1 + message_length;
+				conn->inCursor = conn->inStart;
+				return message_length - 4;
+			}
+		}
+		if (!read_more) {
+			/* note that we cannot grow the input buffer here, as that might move previously returned messages */
+			return -1;
+		}
+		if (available >= COPY_DATA_HEADER_LENGTH &&
+		    pqCheckInBufferSpace(conn->inStart + (size_t)message_length + 1, conn)) {
+			/* the entire message needs to fit in the input buffer */
+			return -2;
+		}
+		/* wait for more data to arrive - note that this invalidates all previously returned messages */
+		if (pqWait(1, 0, conn) || pqReadData(conn) < 0) {
+			return -2;
+		}
+	}
+}
+#endif
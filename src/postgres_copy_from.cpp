@@ -1,5 +1,6 @@
 #include "postgres_connection.hpp"
 #include "postgres_binary_reader.hpp"
+#include "postgres_copy_data.h"
 
 namespace duckdb {
 
@@ -11,4 +12,59 @@ void PostgresConnection::BeginCopyFrom(const string &query, ExecStatusType expec
 	}
 }
 
+bool PostgresConnection::GetCopyData(char *&buffer, idx_t &length, bool &owned) {
+	auto conn = GetConn();
+	const char *in_place_buffer = nullptr;
+	int len = PostgresGetCopyDataInPlace(conn, &in_place_buffer, 1);
+	if (len > 0) {
+		buffer = const_cast<char *>(in_place_buffer);
+		owned = false;
+	} else if (len == 0) {
+		// not a plain CopyData message - let libpq handle it
+		buffer = nullptr;
+		len = PQgetCopyData(conn, &buffer, 0);
+		// len -1 signals end
+		if (len == -1) {
+			FinishCopyFrom();
+			return false;
+		}
+		owned = true;
+	}
+	// len -2 is error
+	if (len < 0 || !buffer) {
+		throw IOException("Unable to read binary COPY data from Postgres: %s", string(PQerrorMessage(conn)));
+	}
+	length = NumericCast<idx_t>(len);
+	return true;
+}
+
+bool PostgresConnection::GetBufferedCopyData(char *&buffer, idx_t &length) {
+	const char *in_place_buffer = nullptr;
+	int len = PostgresGetCopyDataInPlace(GetConn(), &in_place_buffer, 0);
+	if (len <= 0) {
+		return false;
+	}
+	buffer = const_cast<char *>(in_place_buffer);
+	length = NumericCast<idx_t>(len);
+	return true;
+}
+
+void PostgresConnection::FinishCopyFrom() {
+	// consume all available results
+	while (true) {
+		PostgresResult pg_res(PQgetResult(GetConn()));
+		auto final_result = pg_res.res;
+		if (!final_result) {
+			break;
+		}
+		if (PQresultStatus(final_result) != PGRES_COMMAND_OK) {
+			string error = PQresultErrorMessage(final_result);
+			if (error.empty()) {
+				error = PQerrorMessage(GetConn());
+			}
+			throw IOException("Failed to finish COPY: %s", error);
+		}
+	}
+}
+
 } // namespace duckdb
@@ -0,0 +1,170 @@
+#include "postgres_copy_prefetcher.hpp"
+#include "postgres_connection.hpp"
+
+namespace duckdb {
+
+PostgresCopyBuffer::PostgresCopyBuffer(idx_t capacity)
+    : data(Allocator::DefaultAllocator().Allocate(capacity)) {
+}
+
+bool PostgresCopyBuffer::HasSpace(idx_t message_len) const {
+	return size + sizeof(uint32_t) + message_len <= data.GetSize();
+}
+
+void PostgresCopyBuffer::Append(const char *message, idx_t message_len) {
+	if (!HasSpace(message_len)) {
+		// a single message that does not fit - grow the buffer
+		auto new_data = Allocator::DefaultAllocator().Allocate(NextPowerOfTwo(size + sizeof(uint32_t) + message_len));
+		memcpy(new_data.get(), data.get(), size);
+		data = std::move(new_data);
+	}
+	Store<uint32_t>(NumericCast<uint32_t>(message_len), data.get() + size);
+	memcpy(data.get() + size + sizeof(uint32_t), message, message_len);
+	size += sizeof(uint32_t) + message_len;
+}
+
+void PostgresCopyBuffer::Reset() {
+	size = 0;
+	end_of_copy = false;
+}
+
+PostgresCopyPrefetcher::PostgresCopyPrefetcher(PostgresConnection &con_p) : con(con_p) {
+	prefetch_thread = thread([this]() { Run(); });
+}
+
+PostgresCopyPrefetcher::~PostgresCopyPrefetcher() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	buffer_available.notify_all();
+	space_available.notify_all();
+	copy_available.notify_all();
+	if (prefetch_thread.joinable()) {
+		prefetch_thread.join();
+	}
+}
+
+void PostgresCopyPrefetcher::EnqueueCopy(const string &sql) {
+	{
+		lock_guard<mutex> guard(lock);
+		pending_copies.push_back(sql);
+	}
+	copy_available.notify_one();
+}
+
+shared_ptr<PostgresCopyBuffer> PostgresCopyPrefetcher::NextBuffer() {
+	unique_lock<mutex> guard(lock);
+	buffer_available.wait(guard, [&]() { return !filled_buffers.empty() || error.HasError(); });
+	if (filled_buffers.empty()) {
+		// the background thread failed - report the error to the reader
+		error.Throw();
+	}
+	auto result = std::move(filled_buffers.front());
+	filled_buffers.pop_front();
+	space_available.notify_one();
+	return result;
+}
+
+void PostgresCopyPrefetcher::ReturnBuffer(shared_ptr<PostgresCopyBuffer> buffer) {
+	if (buffer.use_count() > 1) {
+		// strings in the buffer are still referenced by a vector - the vector frees the buffer once it is done
+		return;
+	}
+	lock_guard<mutex> guard(lock);
+	free_buffers.push_back(std::move(buffer));
+}
+
+void PostgresCopyPrefetcher::Run() {
+	try {
+		while (true) {
+			string sql;
+			{
+				unique_lock<mutex> guard(lock);
+				copy_available.wait(guard, [&]() { return shutdown || !pending_copies.empty(); });
+				if (shutdown) {
+					return;
+				}
+				sql = std::move(pending_copies.front());
+				pending_copies.pop_front();
+			}
+			FetchCopy(sql);
+		}
+	} catch (std::exception &ex) {
+		{
+			lock_guard<mutex> guard(lock);
+			error = ErrorData(ex);
+		}
+		buffer_available.notify_all();
+	}
+}
+
+void PostgresCopyPrefetcher::FetchCopy(const string &sql) {
+	con.BeginCopyFrom(sql, PGRES_COPY_OUT);
+	auto buffer = GetFreeBuffer();
+	if (!buffer) {
+		return;
+	}
+	while (true) {
+		char *message;
+		idx_t len;
+		bool owned;
+		if (!con.GetCopyData(message, len, owned)) {
+			break;
+		}
+		// we expect at least 2 bytes in each message for the tuple count
+		if (len < sizeof(int16_t)) {
+			throw IOException("Unable to read binary COPY data from Postgres: %s",
+			                  string(PQerrorMessage(con.GetConn())));
+		}
+		if (buffer->size > 0 && !buffer->HasSpace(len)) {
+			// this buffer is full - hand it to the reader
+			if (!PushBuffer(std::move(buffer))) {
+				buffer = nullptr;
+			} else {
+				buffer = GetFreeBuffer();
+			}
+			if (!buffer) {
+				if (owned) {
+					PQfreemem(message);
+				}
+				return;
+			}
+		}
+		buffer->Append(message, len);
+		if (owned) {
+			PQfreemem(message);
+		}
+	}
+	buffer->end_of_copy = true;
+	PushBuffer(std::move(buffer));
+}
+
+shared_ptr<PostgresCopyBuffer> PostgresCopyPrefetcher::GetFreeBuffer() {
+	unique_lock<mutex> guard(lock);
+	space_available.wait(guard, [&]() { return shutdown || filled_buffers.size() < MAX_FILLED_BUFFERS; });
+	if (shutdown) {
+		return nullptr;
+	}
+	if (free_buffers.empty()) {
+		return make_shared_ptr<PostgresCopyBuffer>(idx_t(BUFFER_SIZE));
+	}
+	auto result = std::move(free_buffers.back());
+	free_buffers.pop_back();
+	result->Reset();
+	return result;
+}
+
+bool PostgresCopyPrefetcher::PushBuffer(shared_ptr<PostgresCopyBuffer> buffer) {
+	{
+		lock_guard<mutex> guard(lock);
+		if (shutdown) {
+			return false;
+		}
+		filled_buffers.push_back(std::move(buffer));
+	}
+	buffer_available.notify_one();
+	return true;
+}
+
+} // namespace duckdb
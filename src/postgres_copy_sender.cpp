@@ -0,0 +1,130 @@
+#include "postgres_copy_sender.hpp"
+#include "postgres_connection.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+PostgresCopyFrame::PostgresCopyFrame(idx_t capacity) : data(Allocator::DefaultAllocator().Allocate(capacity)) {
+}
+
+void PostgresCopyFrame::Append(const_data_ptr_t buffer, idx_t len) {
+	if (size + len > data.GetSize()) {
+		// the data does not fit - grow the frame
+		auto new_data = Allocator::DefaultAllocator().Allocate(NextPowerOfTwo(size + len));
+		memcpy(new_data.get(), data.get(), size);
+		data = std::move(new_data);
+	}
+	memcpy(data.get() + size, buffer, len);
+	size += len;
+}
+
+PostgresCopySender::PostgresCopySender(PostgresConnection &con_p) : con(con_p) {
+	sender_thread = thread([this]() { Run(); });
+}
+
+PostgresCopySender::~PostgresCopySender() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	frame_available.notify_all();
+	space_available.notify_all();
+	// the sender finishes the frame it is writing - queued frames are discarded
+	if (sender_thread.joinable()) {
+		sender_thread.join();
+	}
+}
+
+void PostgresCopySender::CheckError() {
+	if (error.HasError()) {
+		// the background thread failed - report the error to the producer
+		error.Throw();
+	}
+}
+
+void PostgresCopySender::Append(const_data_ptr_t buffer, idx_t len) {
+	if (!current_frame) {
+		unique_lock<mutex> guard(lock);
+		CheckError();
+		if (free_frames.empty()) {
+			current_frame = make_uniq<PostgresCopyFrame>(idx_t(FRAME_SIZE));
+		} else {
+			current_frame = std::move(free_frames.back());
+			free_frames.pop_back();
+		}
+	}
+	current_frame->Append(buffer, len);
+	if (current_frame->size >= FRAME_SIZE) {
+		PushFrame();
+	}
+}
+
+void PostgresCopySender::PushFrame() {
+	{
+		unique_lock<mutex> guard(lock);
+		// back-pressure: wait until the sender has caught up
+		space_available.wait(guard, [&]() { return pending_frames.size() < MAX_PENDING_FRAMES || error.HasError(); });
+		CheckError();
+		pending_frames.push_back(std::move(current_frame));
+	}
+	frame_available.notify_one();
+}
+
+void PostgresCopySender::Finish() {
+	if (current_frame && current_frame->size > 0) {
+		PushFrame();
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		finished = true;
+	}
+	frame_available.notify_one();
+	if (sender_thread.joinable()) {
+		sender_thread.join();
+	}
+	CheckError();
+}
+
+void PostgresCopySender::Run() {
+	try {
+		while (true) {
+			unique_ptr<PostgresCopyFrame> frame;
+			{
+				unique_lock<mutex> guard(lock);
+				frame_available.wait(guard, [&]() { return shutdown || finished || !pending_frames.empty(); });
+				if (shutdown || pending_frames.empty()) {
+					return;
+				}
+				frame = std::move(pending_frames.front());
+				pending_frames.pop_front();
+			}
+			space_available.notify_one();
+			SendFrame(*frame);
+			frame->size = 0;
+			lock_guard<mutex> guard(lock);
+			free_frames.push_back(std::move(frame));
+		}
+	} catch (std::exception &ex) {
+		{
+			lock_guard<mutex> guard(lock);
+			error = ErrorData(ex);
+		}
+		space_available.notify_all();
+	}
+}
+
+void PostgresCopySender::SendFrame(PostgresCopyFrame &frame) {
+	// the connection is in blocking mode - libpq waits until the socket can be written to, and consumes any input the
+	// server sends in the meantime (e.g. a notice or an error) so that the server can continue reading
+	auto conn = con.GetConn();
+	if (PQputCopyData(conn, char_ptr_cast(frame.data.get()), NumericCast<int>(frame.size)) != 1) {
+		throw IOException("Error during PQputCopyData: %s", string(PQerrorMessage(conn)));
+	}
+	// push the frame onto the wire
+	if (PQflush(conn) != 0) {
+		throw IOException("Error during PQflush: %s", string(PQerrorMessage(conn)));
+	}
+}
+
+} // namespace duckdb
@@ -1,11 +1,21 @@
 #include "postgres_connection.hpp"
 #include "postgres_binary_writer.hpp"
+#include "postgres_binary_encoder.hpp"
+#include "postgres_copy_sender.hpp"
 #include "postgres_text_writer.hpp"
 #include "storage/postgres_table_entry.hpp"
 
 namespace duckdb {
 
+PostgresCopyState::PostgresCopyState() = default;
+
+PostgresCopyState::~PostgresCopyState() = default;
+
 void PostgresCopyState::Initialize(ClientContext &context) {
+	Value async_copy;
+	if (context.TryGetCurrentSetting("pg_use_async_copy", async_copy)) {
+		use_async_copy = BooleanValue::Get(async_copy);
+	}
 	Value replacement_value;
 	if (!context.TryGetCurrentSetting("pg_null_byte_replacement", replacement_value)) {
 		return;
@@ -61,11 +71,14 @@ void PostgresConnection::BeginCopyTo(ClientContext &context, PostgresCopyState &
 	if (!result || PQresultStatus(result) != PGRES_COPY_IN) {
 		throw std::runtime_error("Failed to prepare COPY \"" + query + "\": " + string(PQresultErrorMessage(result)));
 	}
+	if (state.use_async_copy) {
+		state.sender = make_uniq<PostgresCopySender>(*this);
+	}
 	if (state.format == PostgresCopyFormat::BINARY) {
 		// binary copy requires a header
 		PostgresBinaryWriter writer(state);
 		writer.WriteHeader();
-		CopyData(writer);
+		CopyData(state, writer);
 	}
 }
 
@@ -79,12 +92,20 @@ void PostgresConnection::CopyData(data_ptr_t buffer, idx_t size) {
 	}
 }
 
-void PostgresConnection::CopyData(PostgresBinaryWriter &writer) {
-	CopyData(writer.stream.GetData(), writer.stream.GetPosition());
+void PostgresConnection::CopyData(PostgresCopyState &state, data_ptr_t buffer, idx_t size) {
+	if (state.sender) {
+		state.sender->Append(buffer, size);
+		return;
+	}
+	CopyData(buffer, size);
+}
+
+void PostgresConnection::CopyData(PostgresCopyState &state, PostgresBinaryWriter &writer) {
+	CopyData(state, writer.stream.GetData(), writer.stream.GetPosition());
 }
 
-void PostgresConnection::CopyData(PostgresTextWriter &writer) {
-	CopyData(writer.stream.GetData(), writer.stream.GetPosition());
+void PostgresConnection::CopyData(PostgresCopyState &state, PostgresTextWriter &writer) {
+	CopyData(state, writer.GetData(), writer.GetSize());
 }
 
 void PostgresConnection::FinishCopyTo(PostgresCopyState &state) {
@@ -92,12 +113,30 @@ void PostgresConnection::FinishCopyTo(PostgresCopyState &state) {
 		// binary copy requires a footer
 		PostgresBinaryWriter writer(state);
 		writer.WriteFooter();
-		CopyData(writer);
+		CopyData(state, writer);
 	} else if (state.format == PostgresCopyFormat::TEXT) {
 		// text copy requires a footer
 		PostgresTextWriter writer(state);
 		writer.WriteFooter();
-		CopyData(writer);
+		CopyData(state, writer);
+	}
+	if (state.sender) {
+		// wait until all data has been sent
+		auto sender = std::move(state.sender);
+		try {
+			sender->Finish();
+		} catch (std::exception &ex) {
+			// sending failed (e.g. the server raised an error) - end the COPY so the connection can be used again
+			// and report the error of the server if there is one
+			ErrorData error(ex);
+			PQputCopyEnd(GetConn(), error.RawMessage().c_str());
+			PostgresResult pg_res(PQgetResult(GetConn()));
+			auto result = pg_res.res;
+			if (result && PQresultStatus(result) == PGRES_FATAL_ERROR) {
+				throw std::runtime_error("Failed to copy data: " + string(PQresultErrorMessage(result)));
+			}
+			throw;
+		}
 	}
 
 	auto result_code = PQputCopyEnd(GetConn(), nullptr);
@@ -113,22 +152,28 @@ void PostgresConnection::FinishCopyTo(PostgresCopyState &state) {
 	}
 }
 
-bool NeedsQuotes(const string &to_quote, idx_t size) {
+static bool NeedsQuotes(string_t to_quote) {
 	// Check if the string contains list or struct specific characters, or if it's empty or starts/ends with whitespaces
-	if (size <= 0) {
+	auto size = to_quote.GetSize();
+	auto data = to_quote.GetData();
+	if (size == 0) {
 		// Always quote the empty string
 		return true;
 	}
-	if (isspace(to_quote[0])) {
+	if (isspace(data[0])) {
 		// The string starts with whitespace, we need to preserve it
 		return true;
 	}
-	if (isspace(to_quote[size - 1])) {
+	if (isspace(data[size - 1])) {
 		// The string ends with whitespace, we need to preserve it
 		return true;
 	}
+	if (size == 4 && StringUtil::CIEquals(string(data, size), "null")) {
+		// an unquoted NULL is read as a NULL value
+		return true;
+	}
 	for (idx_t c = 0; c < size; c++) {
-		switch (to_quote[c]) {
+		switch (data[c]) {
 		case '"':
 		case '\\':
 		case '{':
@@ -142,107 +187,6 @@ bool NeedsQuotes(const string &to_quote, idx_t size) {
 	return false;
 }
 
-void EscapeQuotes(const string &to_escape, string &result, idx_t size) {
-	// Escape quotes and backslashes so that the string can be quoted
-	for (idx_t c = 0; c < size; c++) {
-		switch (to_escape[c]) {
-		case '"':
-		case '\\':
-			result += "\\";
-		}
-		result += to_escape[c];
-	}
-}
-
-void QuoteAndEscapeIfNeeded(const string &to_quote, string &result, idx_t size) {
-	// Quote the string iff it contains list or struct specific characters
-	if (!NeedsQuotes(to_quote, size)) {
-		result += to_quote;
-		return;
-	}
-	result += '"';
-	EscapeQuotes(to_quote, result, size);
-	result += '"';
-}
-
-void CastToPostgresVarchar(ClientContext &context, Vector &input, Vector &result, idx_t size);
-
-void CastListToPostgresArray(ClientContext &context, Vector &input, Vector &varchar_vector, idx_t size) {
-	// cast child list
-	auto &child_data = ListVector::GetEntry(input);
-	auto child_count = ListVector::GetListSize(input);
-	bool skip_quoting = child_data.GetType().id() == LogicalTypeId::LIST; // Do not quote dimensions in multi-D arrays
-	Vector child_varchar(LogicalType::VARCHAR, child_count);
-	CastToPostgresVarchar(context, child_data, child_varchar, child_count);
-
-	// construct the list entries
-	auto child_entries = FlatVector::GetData<string_t>(child_varchar);
-	auto list_entries = FlatVector::GetData<list_entry_t>(input);
-	auto result_entries = FlatVector::GetData<string_t>(varchar_vector);
-	for (idx_t r = 0; r < size; r++) {
-		if (FlatVector::IsNull(input, r)) {
-			FlatVector::SetNull(varchar_vector, r, true);
-			continue;
-		}
-		auto list_entry = list_entries[r];
-		string result;
-		result = "{";
-		for (idx_t list_idx = 0; list_idx < list_entry.length; list_idx++) {
-			if (list_idx > 0) {
-				result += ",";
-			}
-			auto child_idx = list_entry.offset + list_idx;
-			if (FlatVector::IsNull(child_varchar, child_idx)) {
-				result += "NULL";
-			} else {
-				auto child = child_entries[child_idx];
-				if (skip_quoting) {
-					result += child.GetString();
-				} else {
-					QuoteAndEscapeIfNeeded(child.GetString(), result, child.GetSize());
-				}
-			}
-		}
-		result += "}";
-		result_entries[r] = StringVector::AddString(varchar_vector, result);
-	}
-}
-
-void CastStructToPostgres(ClientContext &context, Vector &input, Vector &varchar_vector, idx_t size) {
-	auto &child_vectors = StructVector::GetEntries(input);
-	// cast child data of structs
-	vector<Vector> child_varchar_vectors;
-	for (idx_t c = 0; c < child_vectors.size(); c++) {
-		Vector child_varchar(LogicalType::VARCHAR, size);
-		CastToPostgresVarchar(context, *child_vectors[c], child_varchar, size);
-		child_varchar_vectors.push_back(std::move(child_varchar));
-	}
-
-	// construct the struct entries
-	auto result_entries = FlatVector::GetData<string_t>(varchar_vector);
-	for (idx_t r = 0; r < size; r++) {
-		if (FlatVector::IsNull(input, r)) {
-			FlatVector::SetNull(varchar_vector, r, true);
-			continue;
-		}
-		string result;
-		result = "(";
-		for (idx_t c = 0; c < child_varchar_vectors.size(); c++) {
-			if (c > 0) {
-				result += ",";
-			}
-			if (FlatVector::IsNull(child_varchar_vectors[c], r)) {
-				result += ""; // Struct literals encode null by omitting the value
-			} else {
-				auto child = FlatVector::GetData<string_t>(child_varchar_vectors[c])[r];
-				QuoteAndEscapeIfNeeded(child.GetString(), result, child.GetSize());
-			}
-		}
-		result += ")";
-		result_entries[r] = StringVector::AddString(varchar_vector, result);
-	}
-}
-
 void CastBlobToPostgres(ClientContext &context, Vector &input, Vector &result, idx_t size) {
 	auto input_data = FlatVector::GetData<string_t>(input);
 	auto result_data = FlatVector::GetData<string_t>(result);
@@ -270,12 +214,6 @@ void CastGeometryToPostgres(ClientContext &context, Vector &input, Vector &resul
 void CastToPostgresVarchar(ClientContext &context, Vector &input, Vector &result, idx_t size) {
 	auto &type = input.GetType();
 	switch (type.id()) {
-	case LogicalTypeId::LIST:
-		CastListToPostgresArray(context, input, result, size);
-		break;
-	case LogicalTypeId::STRUCT:
-		CastStructToPostgres(context, input, result, size);
-		break;
 	case LogicalTypeId::BLOB:
 		if (type.HasAlias() && StringUtil::CIEquals(type.GetAlias(), "wkb_blob")) {
 			CastGeometryToPostgres(context, input, result, size);
@@ -289,23 +227,219 @@ void CastToPostgresVarchar(ClientContext &context, Vector &input, Vector &result
 	}
 }
 
+//! Whether or not values of the type are written directly - other types are cast to VARCHAR first
+static bool WritesTextDirectly(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::UTINYINT:
+	case LogicalTypeId::USMALLINT:
+	case LogicalTypeId::UINTEGER:
+	case LogicalTypeId::UBIGINT:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::ENUM:
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::STRUCT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! A column (or the child of a list or struct) that is written in text format
+struct PostgresTextColumn {
+	PostgresTextColumn(ClientContext &context, Vector &input, idx_t count, optional_ptr<Vector> cast_target = nullptr)
+	    : source(input) {
+		auto &type = input.GetType();
+		if (!WritesTextDirectly(type)) {
+			// cast to VARCHAR up-front
+			if (!cast_target) {
+				cast_vector = make_uniq<Vector>(LogicalType::VARCHAR, count);
+				cast_target = cast_vector.get();
+			}
+			CastToPostgresVarchar(context, input, *cast_target, count);
+			source = *cast_target;
+			return;
+		}
+		switch (type.id()) {
+		case LogicalTypeId::LIST:
+			children.push_back(
+			    make_uniq<PostgresTextColumn>(context, ListVector::GetEntry(input), ListVector::GetListSize(input)));
+			break;
+		case LogicalTypeId::STRUCT:
+			for (auto &child : StructVector::GetEntries(input)) {
+				children.push_back(make_uniq<PostgresTextColumn>(context, *child, count));
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	//! The vector the values are read from - either the input or its VARCHAR cast
+	reference<Vector> source;
+	unique_ptr<Vector> cast_vector;
+	vector<unique_ptr<PostgresTextColumn>> children;
+};
+
+static void WriteTextValue(PostgresTextWriter &writer, PostgresTextColumn &column, idx_t r, idx_t depth);
+
+static string_t GetTextString(Vector &source, idx_t r) {
+	auto &type = source.GetType();
+	if (type.id() != LogicalTypeId::ENUM) {
+		return FlatVector::GetData<string_t>(source)[r];
+	}
+	switch (type.InternalType()) {
+	case PhysicalType::UINT8:
+		return EnumType::GetString(type, FlatVector::GetData<uint8_t>(source)[r]);
+	case PhysicalType::UINT16:
+		return EnumType::GetString(type, FlatVector::GetData<uint16_t>(source)[r]);
+	case PhysicalType::UINT32:
+		return EnumType::GetString(type, FlatVector::GetData<uint32_t>(source)[r]);
+	default:
+		throw InternalException("ENUM can only have unsigned integers (except UINT64) as physical types, got %s",
+		                        TypeIdToString(type.InternalType()));
+	}
+}
+
+//! Write an element of an array or a composite - quoting it if required
+static void WriteTextElement(PostgresTextWriter &writer, PostgresTextColumn &column, idx_t r, idx_t depth) {
+	auto &source = column.source.get();
+	switch (source.GetType().id()) {
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::ENUM: {
+		auto str = GetTextString(source, r);
+		if (!NeedsQuotes(str)) {
+			writer.WriteNestedVarchar(str, depth);
+			return;
+		}
+		writer.WriteNestedChar('"', depth);
+		writer.WriteNestedVarchar(str, depth + 1);
+		writer.WriteNestedChar('"', depth);
+		break;
+	}
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::STRUCT:
+		// nested arrays and composites always contain characters that must be quoted
+		writer.WriteNestedChar('"', depth);
+		WriteTextValue(writer, column, r, depth + 1);
+		writer.WriteNestedChar('"', depth);
+		break;
+	default:
+		// numbers and dates never need to be quoted
+		WriteTextValue(writer, column, r, depth);
+		break;
+	}
+}
+
+static void WriteTextArray(PostgresTextWriter &writer, PostgresTextColumn &column, idx_t r, idx_t depth) {
+	auto list_entry = FlatVector::GetData<list_entry_t>(column.source.get())[r];
+	auto &child = *column.children[0];
+	auto &child_vector = child.source.get();
+	// do not quote dimensions in multi-dimensional arrays
+	bool is_dimension = child_vector.GetType().id() == LogicalTypeId::LIST;
+	writer.WriteCharInternal('{');
+	for (idx_t list_idx = 0; list_idx < list_entry.length; list_idx++) {
+		if (list_idx > 0) {
+			writer.WriteCharInternal(',');
+		}
+		auto child_idx = list_entry.offset + list_idx;
+		if (FlatVector::IsNull(child_vector, child_idx)) {
+			writer.WriteRaw("NULL", 4);
+		} else if (is_dimension) {
+			WriteTextArray(writer, child, child_idx, depth);
+		} else {
+			WriteTextElement(writer, child, child_idx, depth);
+		}
+	}
+	writer.WriteCharInternal('}');
+}
+
+static void WriteTextComposite(PostgresTextWriter &writer, PostgresTextColumn &column, idx_t r, idx_t depth) {
+	writer.WriteCharInternal('(');
+	for (idx_t c = 0; c < column.children.size(); c++) {
+		if (c > 0) {
+			writer.WriteCharInternal(',');
+		}
+		auto &child = *column.children[c];
+		// composite literals encode NULL by omitting the value
+		if (!FlatVector::IsNull(child.source.get(), r)) {
+			WriteTextElement(writer, child, r, depth);
+		}
+	}
+	writer.WriteCharInternal(')');
+}
+
+static void WriteTextValue(PostgresTextWriter &writer, PostgresTextColumn &column, idx_t r, idx_t depth) {
+	auto &source = column.source.get();
+	switch (source.GetType().id()) {
+	case LogicalTypeId::BOOLEAN:
+		writer.WriteBoolean(FlatVector::GetData<bool>(source)[r]);
+		break;
+	case LogicalTypeId::TINYINT:
+		writer.WriteSigned<int8_t>(FlatVector::GetData<int8_t>(source)[r]);
+		break;
+	case LogicalTypeId::SMALLINT:
+		writer.WriteSigned<int16_t>(FlatVector::GetData<int16_t>(source)[r]);
+		break;
+	case LogicalTypeId::INTEGER:
+		writer.WriteSigned<int32_t>(FlatVector::GetData<int32_t>(source)[r]);
+		break;
+	case LogicalTypeId::BIGINT:
+		writer.WriteSigned<int64_t>(FlatVector::GetData<int64_t>(source)[r]);
+		break;
+	case LogicalTypeId::UTINYINT:
+		writer.WriteUnsigned<uint8_t>(FlatVector::GetData<uint8_t>(source)[r]);
+		break;
+	case LogicalTypeId::USMALLINT:
+		writer.WriteUnsigned<uint16_t>(FlatVector::GetData<uint16_t>(source)[r]);
+		break;
+	case LogicalTypeId::UINTEGER:
+		writer.WriteUnsigned<uint32_t>(FlatVector::GetData<uint32_t>(source)[r]);
+		break;
+	case LogicalTypeId::UBIGINT:
+		writer.WriteUnsigned<uint64_t>(FlatVector::GetData<uint64_t>(source)[r]);
+		break;
+	case LogicalTypeId::DATE:
+		writer.WriteDate(FlatVector::GetData<date_t>(source)[r]);
+		break;
+	case LogicalTypeId::TIMESTAMP:
+		writer.WriteTimestamp(FlatVector::GetData<timestamp_t>(source)[r], false);
+		break;
+	case LogicalTypeId::TIMESTAMP_TZ:
+		writer.WriteTimestamp(FlatVector::GetData<timestamp_t>(source)[r], true);
+		break;
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::ENUM:
+		writer.WriteNestedVarchar(GetTextString(source, r), depth);
+		break;
+	case LogicalTypeId::LIST:
+		WriteTextArray(writer, column, r, depth);
+		break;
+	case LogicalTypeId::STRUCT:
+		WriteTextComposite(writer, column, r, depth);
+		break;
+	default:
+		throw InternalException("Unsupported type \"%s\" for the text writer", source.GetType());
+	}
+}
+
 void PostgresConnection::CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk,
                                    DataChunk &varchar_chunk) {
 	chunk.Flatten();
 
 	if (state.format == PostgresCopyFormat::BINARY) {
-		PostgresBinaryWriter writer(state);
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			writer.BeginRow(chunk.ColumnCount());
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				auto &col = chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
-		CopyData(writer);
+		PostgresBinaryEncoder encoder(state);
+		encoder.Encode(chunk);
+		CopyData(state, encoder.GetData(), encoder.GetSize());
 	} else if (state.format == PostgresCopyFormat::TEXT) {
-		// cast columns to varchar
+		// columns of types that are not written directly are cast to varchar first
 		if (varchar_chunk.ColumnCount() == 0) {
 			// not initialized yet
 			vector<LogicalType> varchar_types;
@@ -317,9 +451,10 @@ void PostgresConnection::CopyChunk(ClientContext &context, PostgresCopyState &st
 			varchar_chunk.Reset();
 		}
 		D_ASSERT(chunk.ColumnCount() == varchar_chunk.ColumnCount());
-		// for text format cast to varchar first
+		vector<unique_ptr<PostgresTextColumn>> columns;
 		for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-			CastToPostgresVarchar(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
+			auto &cast_target = varchar_chunk.data[c];
+			columns.push_back(make_uniq<PostgresTextColumn>(context, chunk.data[c], chunk.size(), cast_target));
 		}
 		varchar_chunk.SetCardinality(chunk.size());
 
@@ -329,13 +464,16 @@ void PostgresConnection::CopyChunk(ClientContext &context, PostgresCopyState &st
 				if (c > 0) {
 					writer.WriteSeparator();
 				}
-				D_ASSERT(varchar_chunk.data[c].GetType().id() == LogicalTypeId::VARCHAR);
-				auto &col = varchar_chunk.data[c];
-				writer.WriteValue(col, r);
+				auto &column = *columns[c];
+				if (FlatVector::IsNull(column.source.get(), r)) {
+					writer.WriteNull();
+				} else {
+					WriteTextValue(writer, column, r, 0);
+				}
 			}
 			writer.FinishRow();
 		}
-		CopyData(writer);
+		CopyData(state, writer);
 	}
 }
 
@@ -14,6 +14,7 @@
 #include "duckdb/main/attached_database.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_optimizer.hpp"
+#include "storage/postgres_insert.hpp"
 #include "duckdb/planner/extension_callback.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_context_state.hpp"
@@ -125,6 +126,13 @@ void SetPostgresNullByteReplacement(ClientContext &context, SetScope scope, Valu
 	}
 }
 
+static void SetPostgresParallelInsert(ClientContext &context, SetScope scope, Value &parameter) {
+	if (parameter.IsNull()) {
+		return;
+	}
+	PostgresInsert::GetParallelInsertMode(StringValue::Get(parameter));
+}
+
 static void LoadInternal(ExtensionLoader &loader) {
 	PostgresScanFunction postgres_fun;
 	loader.RegisterFunction(postgres_fun);
@@ -166,6 +174,10 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
 	config.AddExtensionOption("pg_use_ctid_scan", "Whether or not to parallelize scanning using table ctids",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_use_key_range_scan",
+	                          "Whether or not to parallelize scanning using ranges of a key column when ctid scans are "
+	                          "not possible",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
 	config.AddExtensionOption("pg_pages_per_task", "The amount of pages per task", LogicalType::UBIGINT,
 	                          Value::UBIGINT(PostgresBindData::DEFAULT_PAGES_PER_TASK));
 	config.AddExtensionOption("pg_connection_limit", "The maximum amount of concurrent Postgres connections",
@@ -178,6 +190,16 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          Value::BOOLEAN(true), PostgresConnectionPool::PostgresSetConnectionCache);
 	config.AddExtensionOption("pg_experimental_filter_pushdown", "Whether or not to use filter pushdown",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_experimental_aggregate_pushdown",
+	                          "Whether or not to compute aggregates, GROUP BY and DISTINCT over scans in Postgres",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_experimental_join_pushdown",
+	                          "Whether or not to compute joins between scans of the same database in Postgres",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_estimate_query_rows",
+	                          "Whether or not to estimate the number of rows returned by postgres_query using a remote "
+	                          "EXPLAIN when the query is bound",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
 	config.AddExtensionOption("pg_null_byte_replacement",
 	                          "When writing NULL bytes to Postgres, replace them with the given character",
 	                          LogicalType::VARCHAR, Value(), SetPostgresNullByteReplacement);
@@ -187,6 +209,26 @@ static void LoadInternal(ExtensionLoader &loader) {
 	                          "Whether or not to use TEXT protocol to read data. This is slower, but provides better "
 	                          "compatibility with non-Postgres systems",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_use_prefetch",
+	                          "Whether or not to receive binary COPY data on a background thread while previously "
+	                          "received data is being decoded",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_use_async_copy",
+	                          "Whether or not to coalesce the data written using COPY into large frames that are sent "
+	                          "on a background thread while the next rows are being produced",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_text_fetch_size",
+	                          "The number of rows fetched at a time from a cursor when reading data using the TEXT "
+	                          "protocol (0 to read all rows at once)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(PostgresBindData::DEFAULT_TEXT_FETCH_SIZE));
+	config.AddExtensionOption(
+	    "pg_parallel_insert",
+	    "Whether or not to INSERT in parallel over multiple connections (disabled, atomic or bulk). atomic uses "
+	    "two-phase commit (requires max_prepared_transactions > 0) - inserted rows only become visible once the "
+	    "transaction commits. If DuckDB fails or crashes between preparing and committing, the prepared "
+	    "transactions (named duckdb_insert_*) keep their locks until they are cleaned up manually using "
+	    "pg_prepared_xacts. bulk commits the rows of each connection independently",
+	    LogicalType::VARCHAR, Value("disabled"), SetPostgresParallelInsert);
 
 	OptimizerExtension postgres_optimizer;
 	postgres_optimizer.optimize_function = PostgresOptimizer::Optimize;
@@ -1,25 +1,45 @@
 #include "postgres_filter_pushdown.hpp"
 #include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/filter/expression_filter.hpp"
 #include "duckdb/planner/filter/in_filter.hpp"
 #include "duckdb/planner/filter/optional_filter.hpp"
 #include "duckdb/planner/filter/struct_filter.hpp"
 #include "duckdb/common/enum_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
 
 namespace duckdb {
 
-string PostgresFilterPushdown::CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters,
-                                                string op, column_t column_id) {
+bool PostgresFilterPushdown::CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters,
+                                              string op, column_t column_id, const PostgresType &postgres_type,
+                                              string &result) {
 	vector<string> filter_entries;
 	for (auto &filter : filters) {
-		auto filter_str = TransformFilter(column_name, *filter, column_id);
-		if (!filter_str.empty()) {
-			filter_entries.push_back(std::move(filter_str));
+		string filter_str;
+		if (!TryTransformFilter(column_name, *filter, column_id, postgres_type, filter_str)) {
+			return false;
 		}
+		if (filter_str.empty()) {
+			if (op == "OR") {
+				// one of the alternatives does not remove any rows - neither does the disjunction
+				result = string();
+				return true;
+			}
+			continue;
+		}
+		filter_entries.push_back(std::move(filter_str));
 	}
-	if (filter_entries.empty()) {
-		return string();
-	}
-	return "(" + StringUtil::Join(filter_entries, " " + op + " ") + ")";
+	result = filter_entries.empty() ? string() : "(" + StringUtil::Join(filter_entries, " " + op + " ") + ")";
+	return true;
 }
 
 string PostgresFilterPushdown::TransformComparison(ExpressionType type) {
@@ -64,14 +84,22 @@ string TransformLiteral(const Value &val) {
 }
 
 string PostgresFilterPushdown::TransformCTIDLiteral(const Value &constant) {
-	throw InternalException("FIXME: transform ctid literal");
+	// the row id of a Postgres table is the ctid encoded as (page_index << 16) + row_in_page
+	static constexpr const int64_t MAX_ROW_ID = (int64_t(NumericLimits<uint32_t>::Maximum()) << 16LL) + 0xFFFF;
+	auto row_id = constant.GetValue<int64_t>();
+	// offsets start at 1 - so (0,0) is smaller and (4294967295,65535) is larger than any existing ctid
+	row_id = MaxValue<int64_t>(0, MinValue<int64_t>(row_id, MAX_ROW_ID));
+	return StringUtil::Format("'(%d,%d)'::TID", row_id >> 16LL, row_id & 0xFFFF);
 }
 
 string PostgresFilterPushdown::TransformConstantFilter(string &column_name, ConstantFilter &constant_filter,
                                                        column_t column_id) {
 	string constant_string;
 	if (IsVirtualColumn(column_id)) {
-		return "FALSE";
+		if (constant_filter.constant.IsNull()) {
+			return "FALSE";
+		}
+		constant_string = TransformCTIDLiteral(constant_filter.constant);
 	} else {
 		constant_string = TransformLiteral(constant_filter.constant);
 	}
@@ -79,70 +107,730 @@ string PostgresFilterPushdown::TransformConstantFilter(string &column_name, Cons
 	return StringUtil::Format("%s %s %s", column_name, operator_string, constant_string);
 }
 
-string PostgresFilterPushdown::TransformFilter(string &column_name, TableFilter &filter, column_t column_id) {
+string PostgresFilterPushdown::TransformDynamicFilter(string &column_name, DynamicFilter &filter, column_t column_id) {
+	if (!filter.filter_data || IsVirtualColumn(column_id)) {
+		return string();
+	}
+	// dynamic filters (e.g. the boundary of a Top-N) are updated while the query runs - use the current value
+	lock_guard<mutex> guard(filter.filter_data->lock);
+	if (!filter.filter_data->initialized || !filter.filter_data->filter) {
+		return string();
+	}
+	auto &constant_filter = *filter.filter_data->filter;
+	switch (constant_filter.constant.type().InternalType()) {
+	case PhysicalType::VARCHAR:
+		// the order of strings depends on the collation in Postgres - leave these to DuckDB
+		return string();
+	default:
+		break;
+	}
+	return TransformConstantFilter(column_name, constant_filter, column_id);
+}
+
+//! Whether or not the values of an IN filter can be sent as a single array literal
+static bool SupportsArrayLiteral(const InFilter &filter) {
+	for (auto &val : filter.values) {
+		if (val.IsNull() || val.type().IsNested() || val.type().id() == LogicalTypeId::BLOB) {
+			return false;
+		}
+	}
+	return true;
+}
+
+string PostgresFilterPushdown::TransformInFilter(string &column_name, InFilter &in_filter, column_t column_id) {
+	if (IsVirtualColumn(column_id) || !SupportsArrayLiteral(in_filter)) {
+		string in_list;
+		for (auto &val : in_filter.values) {
+			if (!in_list.empty()) {
+				in_list += ", ";
+			}
+			in_list += IsVirtualColumn(column_id) ? TransformCTIDLiteral(val) : TransformLiteral(val);
+		}
+		return column_name + " IN (" + in_list + ")";
+	}
+	// send the values as a single array literal that is converted to the type of the column by Postgres - this is
+	// much cheaper to build, send and parse than a list of constants for large IN lists (e.g. from join filters)
+	string array_literal = "{";
+	for (auto &val : in_filter.values) {
+		if (array_literal.size() > 1) {
+			array_literal += ",";
+		}
+		array_literal += "\"";
+		for (auto c : val.ToString()) {
+			if (c == '"' || c == '\\') {
+				array_literal += '\\';
+			}
+			array_literal += c;
+		}
+		array_literal += "\"";
+	}
+	array_literal += "}";
+	return column_name + " = ANY(" + KeywordHelper::WriteQuoted(array_literal) + ")";
+}
+
+bool PostgresFilterPushdown::TryTransformFilter(string &column_name, TableFilter &filter, column_t column_id,
+                                                const PostgresType &postgres_type, string &result) {
 	switch (filter.filter_type) {
 	case TableFilterType::IS_NULL:
-		return column_name + " IS NULL";
+		result = column_name + " IS NULL";
+		return true;
 	case TableFilterType::IS_NOT_NULL:
-		return column_name + " IS NOT NULL";
+		result = column_name + " IS NOT NULL";
+		return true;
 	case TableFilterType::CONJUNCTION_AND: {
 		auto &conjunction_filter = filter.Cast<ConjunctionAndFilter>();
-		return CreateExpression(column_name, conjunction_filter.child_filters, "AND", column_id);
+		return CreateExpression(column_name, conjunction_filter.child_filters, "AND", column_id, postgres_type,
+		                        result);
 	}
 	case TableFilterType::CONJUNCTION_OR: {
 		auto &conjunction_filter = filter.Cast<ConjunctionOrFilter>();
-		return CreateExpression(column_name, conjunction_filter.child_filters, "OR", column_id);
+		return CreateExpression(column_name, conjunction_filter.child_filters, "OR", column_id, postgres_type, result);
 	}
 	case TableFilterType::CONSTANT_COMPARISON: {
 		auto &constant_filter = filter.Cast<ConstantFilter>();
-		return TransformConstantFilter(column_name, constant_filter, column_id);
+		result = TransformConstantFilter(column_name, constant_filter, column_id);
+		return true;
 	}
 	case TableFilterType::STRUCT_EXTRACT: {
 		auto &struct_filter = filter.Cast<StructFilter>();
 		auto child_name = KeywordHelper::WriteQuoted(struct_filter.child_name, '\"');
 		auto new_name = "(" + column_name + ")." + child_name;
-		return TransformFilter(new_name, *struct_filter.child_filter, column_id);
+		PostgresType child_type;
+		if (struct_filter.child_idx < postgres_type.children.size()) {
+			child_type = postgres_type.children[struct_filter.child_idx];
+		}
+		return TryTransformFilter(new_name, *struct_filter.child_filter, column_id, child_type, result);
 	}
 	case TableFilterType::OPTIONAL_FILTER: {
+		// optional filters only prune rows - DuckDB does not rely on them, so they can be skipped
 		auto &optional_filter = filter.Cast<OptionalFilter>();
-		return TransformFilter(column_name, *optional_filter.child_filter, column_id);
+		if (!TryTransformFilter(column_name, *optional_filter.child_filter, column_id, postgres_type, result)) {
+			result = string();
+		}
+		return true;
 	}
 	case TableFilterType::IN_FILTER: {
 		auto &in_filter = filter.Cast<InFilter>();
-		string in_list;
-		for (auto &val : in_filter.values) {
-			if (!in_list.empty()) {
-				in_list += ", ";
+		result = TransformInFilter(column_name, in_filter, column_id);
+		return true;
+	}
+	case TableFilterType::DYNAMIC_FILTER: {
+		// dynamic filters only prune rows as well - the operator that sets them still applies them
+		auto &dynamic_filter = filter.Cast<DynamicFilter>();
+		result = TransformDynamicFilter(column_name, dynamic_filter, column_id);
+		return true;
+	}
+	case TableFilterType::EXPRESSION_FILTER: {
+		// table filters are not evaluated again after the scan - only expressions that can be evaluated by
+		// Postgres are accepted as table filters (see PostgresPushdownExpression)
+		auto &expression_filter = filter.Cast<ExpressionFilter>();
+		vector<PostgresFilterColumn> columns;
+		columns.emplace_back(IsVirtualColumn(column_id) ? string() : column_name, postgres_type);
+		result = TransformExpression(*expression_filter.expr, columns);
+		return !result.empty();
+	}
+	default:
+		return false;
+	}
+}
+
+static string GetPostgresTypeName(const LogicalType &type) {
+	if (type.HasAlias()) {
+		return string();
+	}
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		return "BOOLEAN";
+	case LogicalTypeId::SMALLINT:
+		return "INT2";
+	case LogicalTypeId::INTEGER:
+		return "INT4";
+	case LogicalTypeId::BIGINT:
+		return "INT8";
+	case LogicalTypeId::FLOAT:
+		return "FLOAT4";
+	case LogicalTypeId::DOUBLE:
+		return "FLOAT8";
+	case LogicalTypeId::DECIMAL:
+		return StringUtil::Format("NUMERIC(%d,%d)", DecimalType::GetWidth(type), DecimalType::GetScale(type));
+	case LogicalTypeId::DATE:
+		return "DATE";
+	case LogicalTypeId::TIME:
+		return "TIME";
+	case LogicalTypeId::TIMESTAMP:
+		return "TIMESTAMP";
+	case LogicalTypeId::INTERVAL:
+		return "INTERVAL";
+	case LogicalTypeId::VARCHAR:
+		return "TEXT";
+	case LogicalTypeId::UUID:
+		return "UUID";
+	case LogicalTypeId::BLOB:
+		return "BYTEA";
+	default:
+		// timestamps with time zones depend on the TimeZone setting of both systems
+		return string();
+	}
+}
+
+static bool IsIntegerType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsNumericType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DECIMAL:
+		return true;
+	default:
+		return IsIntegerType(type);
+	}
+}
+
+static bool IsDateOrTimestamp(const LogicalType &type) {
+	return type.id() == LogicalTypeId::DATE || type.id() == LogicalTypeId::TIMESTAMP;
+}
+
+//! Whether or not values of the type are ordered in the same way by DuckDB and Postgres
+static bool SupportsOrderingPushdown(const LogicalType &type) {
+	if (type.id() == LogicalTypeId::VARCHAR) {
+		// the order of strings depends on the collation in Postgres
+		return false;
+	}
+	return !GetPostgresTypeName(type).empty();
+}
+
+//! Whether or not a cast produces the same result in DuckDB and Postgres
+static bool SupportsCastPushdown(const LogicalType &source, const LogicalType &target) {
+	if (GetPostgresTypeName(source).empty() || GetPostgresTypeName(target).empty()) {
+		return false;
+	}
+	if (IsIntegerType(source)) {
+		return IsNumericType(target);
+	}
+	switch (source.id()) {
+	case LogicalTypeId::FLOAT:
+		return target.id() == LogicalTypeId::DOUBLE;
+	case LogicalTypeId::DECIMAL:
+		// only casts that do not round
+		return target.id() == LogicalTypeId::DECIMAL && DecimalType::GetScale(target) >= DecimalType::GetScale(source);
+	case LogicalTypeId::DATE:
+		return target.id() == LogicalTypeId::TIMESTAMP;
+	default:
+		return false;
+	}
+}
+
+static bool GetConstantString(const Expression &expr, string &result) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT ||
+	    expr.return_type.id() != LogicalTypeId::VARCHAR) {
+		return false;
+	}
+	auto &value = expr.Cast<BoundConstantExpression>().value;
+	if (value.IsNull()) {
+		return false;
+	}
+	result = StringValue::Get(value);
+	return true;
+}
+
+static optional_ptr<const PostgresFilterColumn> GetFilterColumn(const Expression &expr,
+                                                                const vector<PostgresFilterColumn> &columns) {
+	idx_t column_index;
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COLUMN_REF:
+		column_index = expr.Cast<BoundColumnRefExpression>().binding.column_index;
+		break;
+	case ExpressionClass::BOUND_REF:
+		column_index = expr.Cast<BoundReferenceExpression>().index;
+		break;
+	default:
+		return nullptr;
+	}
+	if (column_index >= columns.size() || columns[column_index].name.empty()) {
+		return nullptr;
+	}
+	return &columns[column_index];
+}
+
+//! Escape the LIKE wildcards in a string - using backslash as the escape character
+static string EscapeLikePattern(const string &str) {
+	string result;
+	for (auto c : str) {
+		if (c == '%' || c == '_' || c == '\\') {
+			result += '\\';
+		}
+		result += c;
+	}
+	return result;
+}
+
+//! Maps a date part (or the function that extracts it) to the field used by EXTRACT in Postgres
+static string GetExtractField(const string &part) {
+	static const unordered_map<string, string> EXTRACT_FIELDS {
+	    {"year", "YEAR"},     {"quarter", "QUARTER"}, {"month", "MONTH"},        {"day", "DAY"},
+	    {"dayofmonth", "DAY"}, {"hour", "HOUR"},       {"minute", "MINUTE"},      {"dayofweek", "DOW"},
+	    {"dow", "DOW"},       {"weekday", "DOW"},     {"isodow", "ISODOW"},      {"dayofyear", "DOY"},
+	    {"doy", "DOY"},       {"week", "WEEK"},       {"weekofyear", "WEEK"},    {"isoyear", "ISOYEAR"}};
+	auto entry = EXTRACT_FIELDS.find(StringUtil::Lower(part));
+	return entry == EXTRACT_FIELDS.end() ? string() : entry->second;
+}
+
+static bool IsJsonExtractString(const Expression &expr) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_FUNCTION) {
+		return false;
+	}
+	auto &name = expr.Cast<BoundFunctionExpression>().function.name;
+	return name == "json_extract_string" || name == "->>";
+}
+
+//! Whether or not a value compares the same to a JSON value that is extracted as text by DuckDB and Postgres -
+//! numbers, objects and arrays are not necessarily formatted in the same way
+static bool IsSafeJsonComparison(const Expression &expr) {
+	string str;
+	if (!GetConstantString(expr, str)) {
+		return false;
+	}
+	return str.empty() || !(StringUtil::CharacterIsDigit(str[0]) || str[0] == '-' || str[0] == '{' || str[0] == '[');
+}
+
+static bool TransformExpressionInternal(const Expression &expr, const vector<PostgresFilterColumn> &columns,
+                                        string &result);
+
+static bool TransformJsonExtractString(const BoundFunctionExpression &function,
+                                       const vector<PostgresFilterColumn> &columns, string &result) {
+	if (function.children.size() != 2) {
+		return false;
+	}
+	// the column is cast to JSON by DuckDB
+	reference<const Expression> input = *function.children[0];
+	while (input.get().GetExpressionClass() == ExpressionClass::BOUND_CAST &&
+	       input.get().return_type.id() == LogicalTypeId::VARCHAR) {
+		input = *input.get().Cast<BoundCastExpression>().child;
+	}
+	auto column = GetFilterColumn(input.get(), columns);
+	if (!column || column->postgres_type.info != PostgresTypeAnnotation::JSONB) {
+		return false;
+	}
+	// only plain keys - i.e. paths of the form $.key
+	string path;
+	if (!GetConstantString(*function.children[1], path) || path.size() <= 2 || !StringUtil::StartsWith(path, "$.")) {
+		return false;
+	}
+	auto key = path.substr(2);
+	for (auto c : key) {
+		if (!StringUtil::CharacterIsAlpha(c) && !StringUtil::CharacterIsDigit(c) && c != '_') {
+			return false;
+		}
+	}
+	result = "(" + column->name + " ->> " + KeywordHelper::WriteQuoted(key) + ")";
+	return true;
+}
+
+//! Transform an operand of a comparison - JSON values extracted as text can only be compared to safe constants
+static bool TransformOperand(const Expression &expr, bool json_comparison, const vector<PostgresFilterColumn> &columns,
+                             string &result) {
+	if (IsJsonExtractString(expr)) {
+		return json_comparison && TransformJsonExtractString(expr.Cast<BoundFunctionExpression>(), columns, result);
+	}
+	return TransformExpressionInternal(expr, columns, result);
+}
+
+static bool TransformChildren(const vector<unique_ptr<Expression>> &children,
+                              const vector<PostgresFilterColumn> &columns, vector<string> &result) {
+	for (auto &child : children) {
+		string child_str;
+		if (!TransformExpressionInternal(*child, columns, child_str)) {
+			return false;
+		}
+		result.push_back(std::move(child_str));
+	}
+	return true;
+}
+
+static bool TransformColumn(const Expression &expr, const vector<PostgresFilterColumn> &columns, string &result) {
+	auto column = GetFilterColumn(expr, columns);
+	if (!column || column->postgres_type.info != PostgresTypeAnnotation::STANDARD) {
+		// values that are converted while they are read are not the same in Postgres
+		return false;
+	}
+	if (GetPostgresTypeName(expr.return_type).empty()) {
+		return false;
+	}
+	result = column->name;
+	if (expr.return_type.id() == LogicalTypeId::VARCHAR) {
+		// other types are read as VARCHAR as well (e.g. json) - these need to be cast to use string functions
+		result += "::TEXT";
+	}
+	return true;
+}
+
+static bool TransformConstant(const Value &value, string &result) {
+	auto type_name = GetPostgresTypeName(value.type());
+	if (type_name.empty()) {
+		return false;
+	}
+	if (value.IsNull()) {
+		result = "NULL::" + type_name;
+	} else if (value.type().id() == LogicalTypeId::BLOB) {
+		result = TransformBlob(StringValue::Get(value));
+	} else {
+		result = KeywordHelper::WriteQuoted(value.ToString()) + "::" + type_name;
+	}
+	return true;
+}
+
+static bool TransformComparisonExpression(const BoundComparisonExpression &comparison,
+                                          const vector<PostgresFilterColumn> &columns, string &result) {
+	string op;
+	bool ordering = false;
+	switch (comparison.GetExpressionType()) {
+	case ExpressionType::COMPARE_EQUAL:
+		op = "=";
+		break;
+	case ExpressionType::COMPARE_NOTEQUAL:
+		op = "<>";
+		break;
+	case ExpressionType::COMPARE_DISTINCT_FROM:
+		op = "IS DISTINCT FROM";
+		break;
+	case ExpressionType::COMPARE_NOT_DISTINCT_FROM:
+		op = "IS NOT DISTINCT FROM";
+		break;
+	case ExpressionType::COMPARE_LESSTHAN:
+		op = "<";
+		ordering = true;
+		break;
+	case ExpressionType::COMPARE_GREATERTHAN:
+		op = ">";
+		ordering = true;
+		break;
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+		op = "<=";
+		ordering = true;
+		break;
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		op = ">=";
+		ordering = true;
+		break;
+	default:
+		return false;
+	}
+	if (ordering && !SupportsOrderingPushdown(comparison.left->return_type)) {
+		return false;
+	}
+	string left, right;
+	if (!TransformOperand(*comparison.left, !ordering && IsSafeJsonComparison(*comparison.right), columns, left) ||
+	    !TransformOperand(*comparison.right, !ordering && IsSafeJsonComparison(*comparison.left), columns, right)) {
+		return false;
+	}
+	result = "(" + left + " " + op + " " + right + ")";
+	return true;
+}
+
+static bool TransformBetweenExpression(const BoundBetweenExpression &between,
+                                       const vector<PostgresFilterColumn> &columns, string &result) {
+	if (!SupportsOrderingPushdown(between.input->return_type)) {
+		return false;
+	}
+	string input, lower, upper;
+	if (!TransformExpressionInternal(*between.input, columns, input) ||
+	    !TransformExpressionInternal(*between.lower, columns, lower) ||
+	    !TransformExpressionInternal(*between.upper, columns, upper)) {
+		return false;
+	}
+	result = StringUtil::Format("(%s %s %s AND %s %s %s)", input, between.lower_inclusive ? ">=" : ">", lower, input,
+	                            between.upper_inclusive ? "<=" : "<", upper);
+	return true;
+}
+
+static bool TransformOperatorExpression(const BoundOperatorExpression &op, const vector<PostgresFilterColumn> &columns,
+                                        string &result) {
+	auto &children = op.children;
+	switch (op.GetExpressionType()) {
+	case ExpressionType::OPERATOR_NOT:
+	case ExpressionType::OPERATOR_IS_NULL:
+	case ExpressionType::OPERATOR_IS_NOT_NULL: {
+		string child;
+		if (children.size() != 1 || !TransformOperand(*children[0], true, columns, child)) {
+			return false;
+		}
+		if (op.GetExpressionType() == ExpressionType::OPERATOR_NOT) {
+			result = "(NOT " + child + ")";
+		} else if (op.GetExpressionType() == ExpressionType::OPERATOR_IS_NULL) {
+			result = "(" + child + " IS NULL)";
+		} else {
+			result = "(" + child + " IS NOT NULL)";
+		}
+		return true;
+	}
+	case ExpressionType::COMPARE_IN:
+	case ExpressionType::COMPARE_NOT_IN: {
+		bool json_comparison = true;
+		vector<string> values;
+		for (idx_t i = 1; i < children.size(); i++) {
+			json_comparison = json_comparison && IsSafeJsonComparison(*children[i]);
+			string value;
+			if (!TransformExpressionInternal(*children[i], columns, value)) {
+				return false;
 			}
-			in_list += TransformLiteral(val);
+			values.push_back(std::move(value));
 		}
-		return column_name + " IN (" + in_list + ")";
+		string input;
+		if (values.empty() || !TransformOperand(*children[0], json_comparison, columns, input)) {
+			return false;
+		}
+		auto in = op.GetExpressionType() == ExpressionType::COMPARE_IN ? " IN (" : " NOT IN (";
+		result = "(" + input + in + StringUtil::Join(values, ", ") + "))";
+		return true;
 	}
-	case TableFilterType::DYNAMIC_FILTER:
+	default:
+		return false;
+	}
+}
+
+static bool TransformLikeFunction(const BoundFunctionExpression &function, const vector<PostgresFilterColumn> &columns,
+                                  string &result) {
+	auto &name = function.function.name;
+	auto &children = function.children;
+	bool has_escape = StringUtil::EndsWith(name, "_escape");
+	if (children.size() != (has_escape ? 3 : 2)) {
+		return false;
+	}
+	bool negated = StringUtil::StartsWith(name, "!") || StringUtil::StartsWith(name, "not_");
+	bool case_insensitive = StringUtil::EndsWith(name, "*") || StringUtil::Contains(name, "ilike");
+	string pattern, escape;
+	if (!GetConstantString(*children[1], pattern) || (has_escape && !GetConstantString(*children[2], escape))) {
+		return false;
+	}
+	for (idx_t i = 0; i < pattern.size(); i++) {
+		if (!escape.empty() && pattern[i] == escape[0]) {
+			i++;
+			continue;
+		}
+		if (pattern[i] == '_') {
+			// "_" matches a single character in Postgres but a single byte in DuckDB
+			return false;
+		}
+		if (case_insensitive && (pattern[i] & 0x80)) {
+			// case folding of non-ASCII characters depends on the locale in Postgres
+			return false;
+		}
+	}
+	string input;
+	if (!TransformExpressionInternal(*children[0], columns, input)) {
+		return false;
+	}
+	// DuckDB does not use an escape character by default, Postgres uses backslash
+	result = StringUtil::Format("(%s %s%s %s ESCAPE %s)", input, negated ? "NOT " : "",
+	                            case_insensitive ? "ILIKE" : "LIKE", KeywordHelper::WriteQuoted(pattern),
+	                            KeywordHelper::WriteQuoted(escape));
+	return true;
+}
+
+static bool TransformFunctionExpression(const BoundFunctionExpression &function,
+                                        const vector<PostgresFilterColumn> &columns, string &result) {
+	auto &name = function.function.name;
+	auto &children = function.children;
+	if (name == "~~" || name == "!~~" || name == "~~*" || name == "!~~*" || name == "like_escape" ||
+	    name == "not_like_escape" || name == "ilike_escape" || name == "not_ilike_escape") {
+		return TransformLikeFunction(function, columns, result);
+	}
+	if (name == "prefix" || name == "starts_with" || name == "suffix" || name == "ends_with" || name == "contains") {
+		// rewrite as LIKE - which can make use of indexes on the column
+		string str, input;
+		if (children.size() != 2 || children[0]->return_type.id() != LogicalTypeId::VARCHAR ||
+		    !GetConstantString(*children[1], str) || !TransformExpressionInternal(*children[0], columns, input)) {
+			return false;
+		}
+		auto pattern = EscapeLikePattern(str);
+		if (name != "suffix" && name != "ends_with") {
+			pattern += "%";
+		}
+		if (name != "prefix" && name != "starts_with") {
+			pattern = "%" + pattern;
+		}
+		result = "(" + input + " LIKE " + KeywordHelper::WriteQuoted(pattern) + " ESCAPE '\\')";
+		return true;
+	}
+	if (name == "date_trunc" || name == "datetrunc") {
+		static const unordered_set<string> TRUNC_PARTS {"year", "quarter", "month", "week",
+		                                                "day",  "hour",    "minute", "second"};
+		string part, input;
+		if (children.size() != 2 || !GetConstantString(*children[0], part) ||
+		    !TRUNC_PARTS.count(StringUtil::Lower(part)) || !IsDateOrTimestamp(children[1]->return_type) ||
+		    !IsDateOrTimestamp(function.return_type) || !TransformExpressionInternal(*children[1], columns, input)) {
+			return false;
+		}
+		// date_trunc on a DATE returns a TIMESTAMP WITH TIME ZONE in Postgres
+		result = "date_trunc(" + KeywordHelper::WriteQuoted(StringUtil::Lower(part)) + ", (" + input + ")::TIMESTAMP)";
+		if (function.return_type.id() == LogicalTypeId::DATE) {
+			result = "(" + result + ")::DATE";
+		}
+		return true;
+	}
+	if (name == "+" || name == "-" || name == "*") {
+		// division and modulo are not pushed - Postgres throws an error when dividing by zero
+		if (!IsNumericType(function.return_type) || children.empty() || children.size() > 2) {
+			return false;
+		}
+		for (auto &child : children) {
+			if (!IsNumericType(child->return_type)) {
+				return false;
+			}
+		}
+		vector<string> args;
+		if (!TransformChildren(children, columns, args)) {
+			return false;
+		}
+		result = args.size() == 1 ? "(" + name + args[0] + ")" : "(" + args[0] + " " + name + " " + args[1] + ")";
+		return true;
+	}
+	// date parts - either date_part('part', x) or a function per part (e.g. year(x))
+	string field;
+	if ((name == "date_part" || name == "datepart") && children.size() == 2) {
+		string part;
+		if (GetConstantString(*children[0], part)) {
+			field = GetExtractField(part);
+		}
+	} else if (children.size() == 1) {
+		field = GetExtractField(name);
+	}
+	if (!field.empty()) {
+		string input;
+		auto &input_expr = *children.back();
+		if (!IsIntegerType(function.return_type) || !IsDateOrTimestamp(input_expr.return_type) ||
+		    !TransformExpressionInternal(input_expr, columns, input)) {
+			return false;
+		}
+		// parts of infinite dates are NULL in DuckDB but infinite in Postgres
+		result = StringUtil::Format("(CASE WHEN isfinite(%s) THEN EXTRACT(%s FROM %s)::%s END)", input, field, input,
+		                            GetPostgresTypeName(function.return_type));
+		return true;
+	}
+	return false;
+}
+
+static bool TransformExpressionInternal(const Expression &expr, const vector<PostgresFilterColumn> &columns,
+                                        string &result) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COLUMN_REF:
+	case ExpressionClass::BOUND_REF:
+		return TransformColumn(expr, columns, result);
+	case ExpressionClass::BOUND_CONSTANT:
+		return TransformConstant(expr.Cast<BoundConstantExpression>().value, result);
+	case ExpressionClass::BOUND_CAST: {
+		auto &cast = expr.Cast<BoundCastExpression>();
+		string child;
+		if (cast.try_cast || !SupportsCastPushdown(cast.child->return_type, cast.return_type) ||
+		    !TransformExpressionInternal(*cast.child, columns, child)) {
+			return false;
+		}
+		result = "(" + child + ")::" + GetPostgresTypeName(cast.return_type);
+		return true;
+	}
+	case ExpressionClass::BOUND_COMPARISON:
+		return TransformComparisonExpression(expr.Cast<BoundComparisonExpression>(), columns, result);
+	case ExpressionClass::BOUND_BETWEEN:
+		return TransformBetweenExpression(expr.Cast<BoundBetweenExpression>(), columns, result);
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		auto &conjunction = expr.Cast<BoundConjunctionExpression>();
+		vector<string> children;
+		if (!TransformChildren(conjunction.children, columns, children)) {
+			return false;
+		}
+		auto op = conjunction.GetExpressionType() == ExpressionType::CONJUNCTION_AND ? " AND " : " OR ";
+		result = "(" + StringUtil::Join(children, op) + ")";
+		return true;
+	}
+	case ExpressionClass::BOUND_OPERATOR:
+		return TransformOperatorExpression(expr.Cast<BoundOperatorExpression>(), columns, result);
+	case ExpressionClass::BOUND_FUNCTION:
+		return TransformFunctionExpression(expr.Cast<BoundFunctionExpression>(), columns, result);
+	default:
+		return false;
+	}
+}
+
+string PostgresFilterPushdown::TransformExpression(const Expression &expr,
+                                                   const vector<PostgresFilterColumn> &columns) {
+	if (expr.return_type.id() != LogicalTypeId::BOOLEAN) {
+		return string();
+	}
+	string result;
+	if (!TransformExpressionInternal(expr, columns, result)) {
 		return string();
+	}
+	return result;
+}
+
+bool PostgresFilterPushdown::HasDynamicFilter(TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::DYNAMIC_FILTER:
+		return true;
+	case TableFilterType::CONJUNCTION_AND:
+	case TableFilterType::CONJUNCTION_OR: {
+		auto &conjunction_filter = filter.Cast<ConjunctionFilter>();
+		for (auto &child : conjunction_filter.child_filters) {
+			if (HasDynamicFilter(*child)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	case TableFilterType::STRUCT_EXTRACT:
+		return HasDynamicFilter(*filter.Cast<StructFilter>().child_filter);
+	case TableFilterType::OPTIONAL_FILTER:
+		return HasDynamicFilter(*filter.Cast<OptionalFilter>().child_filter);
 	default:
-		throw InternalException("Unsupported table filter type");
+		return false;
 	}
 }
 
-string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_ids,
-                                                optional_ptr<TableFilterSet> filters, const vector<string> &names) {
+bool PostgresFilterPushdown::HasDynamicFilters(optional_ptr<TableFilterSet> filters) {
+	if (!filters) {
+		return false;
+	}
+	for (auto &entry : filters->filters) {
+		if (HasDynamicFilter(*entry.second)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool PostgresFilterPushdown::TryTransformFilters(const vector<column_t> &column_ids,
+                                                 optional_ptr<TableFilterSet> filters, const vector<string> &names,
+                                                 const vector<PostgresType> &postgres_types, string &result) {
+	result = string();
 	if (!filters || filters->filters.empty()) {
 		// no filters
-		return string();
+		return true;
 	}
-	string result;
 	for (auto &entry : filters->filters) {
 		string column_name;
+		PostgresType postgres_type;
 		auto column_id = column_ids[entry.first];
 		if (IsVirtualColumn(column_id)) {
 			column_name = "ctid";
+			postgres_type.info = PostgresTypeAnnotation::CTID;
 		} else {
 			column_name = KeywordHelper::WriteQuoted(names[column_id], '"');
+			postgres_type = postgres_types[column_id];
 		}
 		auto &filter = *entry.second;
-		auto filter_text = TransformFilter(column_name, filter, column_id);
-
+		string filter_text;
+		if (!TryTransformFilter(column_name, filter, column_id, postgres_type, filter_text)) {
+			return false;
+		}
 		if (filter_text.empty()) {
 			continue;
 		}
@@ -151,6 +839,17 @@ string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_i
 		}
 		result += filter_text;
 	}
+	return true;
+}
+
+string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_ids,
+                                                optional_ptr<TableFilterSet> filters, const vector<string> &names,
+                                                const vector<PostgresType> &postgres_types) {
+	string result;
+	if (!TryTransformFilters(column_ids, filters, names, postgres_types, result)) {
+		throw InternalException("Failed to push a filter into the Postgres scan - the filter cannot be evaluated by "
+		                        "Postgres");
+	}
 	return result;
 }
 
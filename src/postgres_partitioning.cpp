@@ -0,0 +1,54 @@
+#include "postgres_partitioning.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+
+namespace duckdb {
+
+vector<string> PostgresPartitioning::RangePartitions(const string &column_name, const vector<string> &boundaries) {
+	auto column = KeywordHelper::WriteQuoted(column_name, '"');
+	vector<string> result;
+	if (boundaries.empty()) {
+		result.push_back(string());
+		return result;
+	}
+	result.push_back(StringUtil::Format("(%s < %s OR %s IS NULL)", column, boundaries[0], column));
+	for (idx_t i = 1; i < boundaries.size(); i++) {
+		result.push_back(
+		    StringUtil::Format("(%s >= %s AND %s < %s)", column, boundaries[i - 1], column, boundaries[i]));
+	}
+	result.push_back(StringUtil::Format("%s >= %s", column, boundaries.back()));
+	return result;
+}
+
+vector<string> PostgresPartitioning::IntegerRangePartitions(const string &column_name, int64_t min, int64_t max,
+                                                            idx_t partition_count) {
+	vector<string> boundaries;
+	if (max > min && partition_count > 1) {
+		hugeint_t range = hugeint_t(max) - hugeint_t(min) + hugeint_t(1);
+		for (idx_t i = 1; i < partition_count; i++) {
+			auto boundary = hugeint_t(min) + range * hugeint_t(i) / hugeint_t(partition_count);
+			auto literal = boundary.ToString();
+			if (boundary <= hugeint_t(min) || (!boundaries.empty() && boundaries.back() == literal)) {
+				// more partitions than values
+				continue;
+			}
+			boundaries.push_back(std::move(literal));
+		}
+	}
+	return RangePartitions(column_name, boundaries);
+}
+
+vector<string> PostgresPartitioning::HashPartitions(const string &column_name, idx_t partition_count) {
+	auto column = KeywordHelper::WriteQuoted(column_name, '"');
+	vector<string> result;
+	for (idx_t i = 0; i < partition_count; i++) {
+		auto predicate =
+		    StringUtil::Format("mod(abs(hashtext(%s::TEXT)::BIGINT), %d) = %d", column, partition_count, i);
+		if (i == 0) {
+			predicate = StringUtil::Format("(%s OR %s IS NULL)", predicate, column);
+		}
+		result.push_back(std::move(predicate));
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -6,9 +6,53 @@
 #include "duckdb/main/attached_database.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
+#include "postgres_partitioning.hpp"
+#include "postgres_result.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 
 namespace duckdb {
 
+struct PostgresQueryPartitionInfo {
+	string column;
+	string method = "range";
+	idx_t partitions = 0;
+	Value min;
+	Value max;
+};
+
+static void PostgresQueryPartitions(ClientContext &context, PostgresBindData &bind_data,
+                                    const PostgresQueryPartitionInfo &info, const vector<string> &names,
+                                    const vector<LogicalType> &types) {
+	idx_t column_idx;
+	for (column_idx = 0; column_idx < names.size(); column_idx++) {
+		if (names[column_idx] == info.column) {
+			break;
+		}
+	}
+	if (column_idx >= names.size()) {
+		throw BinderException("partition_column \"%s\" is not a column of the result of the query", info.column);
+	}
+	auto partition_count = info.partitions;
+	if (partition_count == 0) {
+		partition_count = NumericCast<idx_t>(TaskScheduler::GetScheduler(context).NumberOfThreads());
+	}
+	auto method = StringUtil::Lower(info.method);
+	if (method == "hash") {
+		bind_data.SetPartitions(PostgresPartitioning::HashPartitions(info.column, partition_count));
+		return;
+	}
+	if (method != "range") {
+		throw BinderException("Unsupported partition_method \"%s\" - expected \"range\" or \"hash\"", info.method);
+	}
+	if (!types[column_idx].IsIntegral()) {
+		throw BinderException("partition_column \"%s\" has type %s - range partitioning requires an integer column, "
+		                      "use partition_method='hash' instead",
+		                      info.column, types[column_idx].ToString());
+	}
+	// missing bounds are fetched when the scan starts - in the snapshot that the partitions are scanned in
+	bind_data.SetRangePartitions(info.column, partition_count, info.min, info.max);
+}
+
 static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctionBindInput &input,
                                             vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<PostgresBindData>(context);
@@ -39,9 +83,20 @@ static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctio
 	}
 
 	bool use_transaction = true;
+	PostgresQueryPartitionInfo partition_info;
 	for (auto &kv : input.named_parameters) {
 		if (kv.first == "use_transaction") {
 			use_transaction = BooleanValue::Get(kv.second);
+		} else if (kv.first == "partition_column") {
+			partition_info.column = StringValue::Get(kv.second);
+		} else if (kv.first == "partition_method") {
+			partition_info.method = StringValue::Get(kv.second);
+		} else if (kv.first == "partitions") {
+			partition_info.partitions = UBigIntValue::Get(kv.second);
+		} else if (kv.first == "partition_min") {
+			partition_info.min = kv.second;
+		} else if (kv.first == "partition_max") {
+			partition_info.max = kv.second;
 		}
 	}
 	result->use_transaction = use_transaction;
@@ -90,6 +145,25 @@ static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctio
 	result->names = names;
 	result->read_only = false;
 	result->SetTablePages(0);
+	if (!partition_info.column.empty()) {
+		// the query is split into partitions that are scanned in parallel - this requires the query to be read-only
+		result->read_only = true;
+		PostgresQueryPartitions(context, *result, partition_info, names, return_types);
+		auto instance_type = pg_catalog.GetPostgresVersion().type_v;
+		if (!use_transaction || instance_type == PostgresInstanceType::REDSHIFT ||
+		    instance_type == PostgresInstanceType::AURORA) {
+			// the partitions are only consistent with each other if they read through the snapshot of the
+			// transaction - without one the query is scanned as a whole instead
+			result->SetPartitions(vector<string>());
+			result->read_only = false;
+		}
+	}
+	Value estimate_rows;
+	if (context.TryGetCurrentSetting("pg_estimate_query_rows", estimate_rows) && BooleanValue::Get(estimate_rows) &&
+	    pg_catalog.GetPostgresVersion().type_v != PostgresInstanceType::REDSHIFT) {
+		// estimating the cardinality costs an additional round trip for every bind of the query
+		result->rows_approx = con.EstimateRows(sql);
+	}
 	result->sql = std::move(sql);
 	return std::move(result);
 }
@@ -97,10 +171,16 @@ static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctio
 PostgresQueryFunction::PostgresQueryFunction()
     : TableFunction("postgres_query", {LogicalType::VARCHAR, LogicalType::VARCHAR}, nullptr, PGQueryBind) {
 	named_parameters["use_transaction"] = LogicalType::BOOLEAN;
+	named_parameters["partition_column"] = LogicalType::VARCHAR;
+	named_parameters["partition_method"] = LogicalType::VARCHAR;
+	named_parameters["partitions"] = LogicalType::UBIGINT;
+	named_parameters["partition_min"] = LogicalType::BIGINT;
+	named_parameters["partition_max"] = LogicalType::BIGINT;
 	PostgresScanFunction scan_function;
 	init_global = scan_function.init_global;
 	init_local = scan_function.init_local;
 	function = scan_function.function;
+	cardinality = scan_function.cardinality;
 	projection_pushdown = true;
 	global_initialization = TableFunctionInitialization::INITIALIZE_ON_SCHEDULE;
 }
@@ -0,0 +1,114 @@
+#include "postgres_scan_materializer.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+PostgresScanMaterializer::PostgresScanMaterializer(ClientContext &context_p, vector<LogicalType> types_p,
+                                                   scan_function_t scan_function_p,
+                                                   optional_ptr<PostgresTransaction> transaction_p)
+    : context(context_p.shared_from_this()), buffer_manager(BufferManager::GetBufferManager(context_p)),
+      types(std::move(types_p)), scan_function(std::move(scan_function_p)), transaction(transaction_p) {
+	if (transaction) {
+		transaction->BeginBackgroundRead();
+	}
+	materialize_thread = thread([this]() { Run(); });
+}
+
+PostgresScanMaterializer::~PostgresScanMaterializer() {
+	{
+		lock_guard<mutex> guard(lock);
+		shutdown = true;
+	}
+	if (materialize_thread.joinable()) {
+		materialize_thread.join();
+	}
+}
+
+void PostgresScanMaterializer::Run() {
+	try {
+		Materialize();
+	} catch (std::exception &ex) {
+		lock_guard<mutex> guard(lock);
+		error = ErrorData(ex);
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		finished = true;
+	}
+	segment_available.notify_all();
+	if (transaction) {
+		transaction->EndBackgroundRead();
+	}
+}
+
+void PostgresScanMaterializer::Materialize() {
+	DataChunk scan_chunk;
+	scan_chunk.Initialize(Allocator::DefaultAllocator(), types);
+
+	auto segment_rows = INITIAL_SEGMENT_ROWS;
+	auto segment = make_uniq<ColumnDataCollection>(buffer_manager, types);
+	ColumnDataAppendState append_state;
+	segment->InitializeAppend(append_state);
+	while (true) {
+		{
+			lock_guard<mutex> guard(lock);
+			if (shutdown) {
+				// the scan has been destroyed before it was exhausted
+				return;
+			}
+		}
+		scan_chunk.Reset();
+		scan_function(*context, scan_chunk);
+		if (scan_chunk.size() == 0) {
+			break;
+		}
+		segment->Append(append_state, scan_chunk);
+		if (segment->Count() >= segment_rows) {
+			// hand the segment to the consumer - small segments first so the first rows are available quickly
+			PushSegment(std::move(segment));
+			segment_rows = MinValue<idx_t>(segment_rows * 2, idx_t(MAX_SEGMENT_ROWS));
+			segment = make_uniq<ColumnDataCollection>(buffer_manager, types);
+			segment->InitializeAppend(append_state);
+		}
+	}
+	if (segment->Count() > 0) {
+		PushSegment(std::move(segment));
+	}
+}
+
+void PostgresScanMaterializer::PushSegment(unique_ptr<ColumnDataCollection> segment) {
+	{
+		lock_guard<mutex> guard(lock);
+		segments.push_back(std::move(segment));
+	}
+	segment_available.notify_one();
+}
+
+void PostgresScanMaterializer::Scan(DataChunk &output) {
+	while (true) {
+		if (current_segment) {
+			current_segment->Scan(scan_state, output);
+			if (output.size() > 0) {
+				return;
+			}
+			// the segment has been scanned entirely - release its memory
+			current_segment.reset();
+		}
+		unique_lock<mutex> guard(lock);
+		segment_available.wait(guard, [&]() { return !segments.empty() || finished; });
+		if (error.HasError()) {
+			// the background thread failed - report the error to the consumer
+			error.Throw();
+		}
+		if (segments.empty()) {
+			// the scan is exhausted
+			return;
+		}
+		current_segment = std::move(segments.front());
+		segments.pop_front();
+		current_segment->InitializeScan(scan_state);
+	}
+}
+
+} // namespace duckdb
@@ -3,14 +3,25 @@
 #include <libpq-fe.h>
 
 #include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/shared_ptr.hpp"
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/profiler.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
+#include "duckdb/planner/expression/bound_between_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 #include "postgres_filter_pushdown.hpp"
+#include "postgres_partitioning.hpp"
 #include "postgres_scanner.hpp"
 #include "postgres_result.hpp"
 #include "postgres_binary_reader.hpp"
 #include "postgres_text_reader.hpp"
+#include "postgres_scan_materializer.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "storage/postgres_table_set.hpp"
@@ -28,34 +39,60 @@ struct PostgresLocalState : public LocalTableFunctionState {
 	string sql;
 	vector<column_t> column_ids;
 	TableFilterSet *filters;
+	//! The column list and the filters of the task queries - which only need to be built once per scan
+	bool task_query_initialized = false;
+	bool has_dynamic_filters = false;
 	string col_names;
+	string filter_string;
 	PostgresConnection connection;
 	idx_t batch_idx = 0;
 	PostgresPoolConnection pool_connection;
 	unique_ptr<PostgresResultReader> reader;
+	//! Whether or not the COPY of the next task has already been handed to the reader
+	bool prefetched_task = false;
+	bool prefetch_exhausted = false;
+	idx_t prefetched_batch_idx = 0;
+	//! The size of the current (and prefetched) task in pages, and the time the current task has been running
+	idx_t task_pages = 0;
+	idx_t prefetched_task_pages = 0;
+	Profiler task_timer;
 
 	void ScanChunk(ClientContext &context, const PostgresBindData &bind_data, PostgresGlobalState &gstate,
 	               DataChunk &output);
 };
 
 struct PostgresGlobalState : public GlobalTableFunctionState {
-	explicit PostgresGlobalState(idx_t max_threads) : page_idx(0), batch_idx(0), max_threads(max_threads) {
+	explicit PostgresGlobalState(idx_t max_threads)
+	    : page_idx(0), page_count(0), batch_idx(0), max_threads(max_threads) {
 	}
 
 	mutable mutex lock;
 	idx_t page_idx;
+	//! The number of pages of the relation at the start of the scan
+	idx_t page_count;
 	idx_t batch_idx;
 	idx_t max_threads;
-	unique_ptr<ColumnDataCollection> collection;
-	ColumnDataScanState scan_state;
+	//! The observed time it takes to scan a page (moving average over finished tasks), or 0 if not yet known
+	double seconds_per_page = 0;
+	//! The scan that materializes the relation, and the materialized rows
+	unique_ptr<LocalTableFunctionState> materialize_state;
+	unique_ptr<PostgresScanMaterializer> materializer;
 	bool used_main_thread = false;
+	//! Whether the relation is scanned and materialized in its entirety up-front
+	bool materialize = false;
 	string snapshot;
+	//! The predicates of the partitions of the scan - range partitions are resolved when the scan starts
+	vector<string> partition_filters;
+	//! The number of rows that have been scanned - only tracked if the scan has a row limit
+	atomic<idx_t> scanned_rows {0};
 
 	PostgresConnection &GetConnection();
 	void SetConnection(PostgresConnection connection);
 	void SetConnection(shared_ptr<OwnedPostgresConnection> connection);
 
 	bool TryOpenNewConnection(ClientContext &context, PostgresLocalState &lstate, const PostgresBindData &bind_data);
+	//! Record the scan speed of a finished task
+	void FinishTask(idx_t task_pages, double seconds);
 	idx_t MaxThreads() const override {
 		return max_threads;
 	}
@@ -64,12 +101,22 @@ private:
 	PostgresConnection connection;
 };
 
-static void PostgresGetSnapshot(PostgresVersion version, const PostgresBindData &bind_data,
+static void PostgresGetSnapshot(ClientContext &context, PostgresVersion version, const PostgresBindData &bind_data,
                                 PostgresGlobalState &gstate) {
 	unique_ptr<PostgresResult> result;
 	// by default disable snapshotting
 	gstate.snapshot = string();
-	if (gstate.max_threads <= 1) {
+	if (gstate.max_threads <= 1 && !bind_data.use_transaction_snapshot) {
+		return;
+	}
+	if (!bind_data.use_transaction) {
+		// the snapshot is only valid for the duration of the transaction that exported it
+		return;
+	}
+	auto pg_catalog = bind_data.GetCatalog();
+	if (pg_catalog) {
+		// all scans of the attached database read through the snapshot exported by its transaction
+		gstate.snapshot = PostgresTransaction::Get(context, *pg_catalog).GetSnapshot();
 		return;
 	}
 	if (version.type_v == PostgresInstanceType::AURORA) {
@@ -142,17 +189,79 @@ PostgresBindData::PostgresBindData(ClientContext &context) {
 			use_text_protocol = true;
 		}
 	}
+	Value prefetch;
+	if (context.TryGetCurrentSetting("pg_use_prefetch", prefetch)) {
+		use_prefetch = BooleanValue::Get(prefetch);
+	}
+	Value fetch_size;
+	if (context.TryGetCurrentSetting("pg_text_fetch_size", fetch_size)) {
+		text_fetch_size = UBigIntValue::Get(fetch_size);
+	}
 }
 
 void PostgresBindData::SetTablePages(idx_t approx_num_pages) {
 	this->pages_approx = approx_num_pages;
-	if (!read_only || use_text_protocol) {
+	if ((!read_only && !use_transaction_snapshot) || use_text_protocol) {
 		max_threads = 1;
 	} else {
 		max_threads = MaxValue<idx_t>(pages_approx / pages_per_task, 1);
 	}
 }
 
+void PostgresBindData::AddSourceFilter(const string &filter) {
+	if (filter.empty()) {
+		return;
+	}
+	source_filter = source_filter.empty() ? filter : source_filter + " AND " + filter;
+}
+
+void PostgresBindData::SetPartitions(vector<string> partition_filters_p) {
+	partition_filters = std::move(partition_filters_p);
+	partition_range_column = string();
+	partition_range_count = 0;
+	SetPartitionThreads(partition_filters.size());
+}
+
+void PostgresBindData::SetRangePartitions(const string &column_name, idx_t partition_count, Value min, Value max) {
+	partition_filters.clear();
+	partition_range_column = column_name;
+	partition_range_count = partition_count;
+	partition_range_min = std::move(min);
+	partition_range_max = std::move(max);
+	SetPartitionThreads(partition_count);
+}
+
+void PostgresBindData::SetPartitionThreads(idx_t partition_count) {
+	// partitions are plain predicates - they can be scanned in parallel over the text protocol as well
+	max_threads = read_only || use_transaction_snapshot ? MaxValue<idx_t>(partition_count, 1) : 1;
+}
+
+bool PostgresBindData::TryUseTransactionSnapshot(ClientContext &context) {
+	if (use_transaction_snapshot) {
+		return true;
+	}
+	if (!pg_catalog || !use_transaction) {
+		return false;
+	}
+	// the snapshot itself is only exported when the scan starts - if it turns out to be unavailable by then (e.g.
+	// because the transaction has written) the scan falls back to materializing over the connection of the
+	// transaction
+	auto &transaction = PostgresTransaction::Get(context, *pg_catalog);
+	if (!transaction.CanExportSnapshot()) {
+		return false;
+	}
+	use_transaction_snapshot = true;
+	requires_materialization = false;
+	can_use_main_thread = false;
+	// the scan no longer has to share the connection of the transaction - it can run in parallel
+	if (!HasPartitions()) {
+		SetTablePages(pages_approx);
+	} else {
+		SetPartitionThreads(partition_range_count > 0 ? partition_range_count : partition_filters.size());
+	}
+	return true;
+}
+
 PostgresConnection &PostgresGlobalState::GetConnection() {
 	return connection;
 }
@@ -196,6 +305,7 @@ static unique_ptr<FunctionData> PostgresBind(ClientContext &context, TableFuncti
 	bind_data->types = return_types;
 	bind_data->can_use_main_thread = true;
 	bind_data->requires_materialization = false;
+	bind_data->rows_approx = info->approx_num_rows;
 
 	PostgresScanFunction::PrepareBind(version, context, *bind_data, info->approx_num_pages);
 	return std::move(bind_data);
@@ -213,55 +323,96 @@ static bool ContainsCastToVarchar(const PostgresType &type) {
 	return false;
 }
 
-static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data_p,
-                                 PostgresLocalState &lstate, idx_t task_min, idx_t task_max) {
-	D_ASSERT(bind_data_p);
-	D_ASSERT(task_min <= task_max);
-
-	auto bind_data = (const PostgresBindData *)bind_data_p;
-
+static string PostgresGetColumnList(const PostgresBindData &bind_data, const vector<column_t> &column_ids) {
 	string col_names;
-	for (auto &column_id : lstate.column_ids) {
+	for (auto &column_id : column_ids) {
 		if (!col_names.empty()) {
 			col_names += ", ";
 		}
+		if (!bind_data.column_expressions.empty()) {
+			// an aggregate has been pushed into the scan
+			col_names += bind_data.column_expressions[column_id];
+			continue;
+		}
 		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
-			if (bind_data->table_name.empty() || !bind_data->emit_ctid) {
+			if (bind_data.table_name.empty() || !bind_data.emit_ctid) {
 				// count(*) over postgres_query
 				col_names += "NULL";
 			} else {
 				col_names += "ctid";
 			}
 		} else {
-			col_names += KeywordHelper::WriteQuoted(bind_data->names[column_id], '"');
-			if (bind_data->postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+			col_names += KeywordHelper::WriteQuoted(bind_data.names[column_id], '"');
+			if (bind_data.postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 				col_names += "::VARCHAR";
-			} else if (bind_data->types[column_id].id() == LogicalTypeId::LIST) {
-				if (bind_data->postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			} else if (bind_data.types[column_id].id() == LogicalTypeId::LIST) {
+				if (bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
 					continue;
 				}
-				if (bind_data->postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+				if (bind_data.postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 					col_names += "::VARCHAR[]";
 				}
 			} else {
-				if (ContainsCastToVarchar(bind_data->postgres_types[column_id])) {
+				if (ContainsCastToVarchar(bind_data.postgres_types[column_id])) {
 					throw NotImplementedException("Error reading table \"%s\" - cast to varchar not implemented for "
 					                              "composite column \"%s\" (type %s)",
-					                              bind_data->table_name, bind_data->names[column_id],
-					                              bind_data->types[column_id].ToString());
+					                              bind_data.table_name, bind_data.names[column_id],
+					                              bind_data.types[column_id].ToString());
 				}
 			}
 		}
 	}
+	return col_names;
+}
 
-	string filter_string =
-	    PostgresFilterPushdown::TransformFilters(lstate.column_ids, lstate.filters, bind_data->names);
+static string PostgresGetFilterString(const PostgresBindData &bind_data, PostgresLocalState &lstate) {
+	string filter_string = PostgresFilterPushdown::TransformFilters(lstate.column_ids, lstate.filters,
+	                                                                bind_data.names, bind_data.postgres_types);
+	if (!bind_data.source_filter.empty()) {
+		filter_string =
+		    filter_string.empty() ? bind_data.source_filter : bind_data.source_filter + " AND " + filter_string;
+	}
+	return filter_string;
+}
 
-	string filter;
+static string PostgresGetTaskQuery(ClientContext &context, const PostgresBindData *bind_data_p,
+                                   PostgresLocalState &lstate, const vector<string> &partitions, idx_t task_min,
+                                   idx_t task_max) {
+	D_ASSERT(bind_data_p);
+	D_ASSERT(task_min <= task_max);
 
-	lstate.exec = false;
-	lstate.done = false;
-	if (bind_data->pages_approx > 0) {
+	auto bind_data = (const PostgresBindData *)bind_data_p;
+
+	// the column list and the filters are the same for every task of the scan - build them only once
+	if (!lstate.task_query_initialized) {
+		lstate.col_names = PostgresGetColumnList(*bind_data, lstate.column_ids);
+		lstate.has_dynamic_filters = PostgresFilterPushdown::HasDynamicFilters(lstate.filters);
+		if (!lstate.has_dynamic_filters) {
+			lstate.filter_string = PostgresGetFilterString(*bind_data, lstate);
+		}
+		lstate.task_query_initialized = true;
+	}
+	auto &col_names = lstate.col_names;
+	// dynamic filters are updated while the query runs - these are transformed again for every task
+	auto filter_string =
+	    lstate.has_dynamic_filters ? PostgresGetFilterString(*bind_data, lstate) : lstate.filter_string;
+
+	string filter;
+	if (bind_data->HasPartitions()) {
+		// the task covers the partitions [task_min, task_max)
+		if (task_min == 0 && task_max >= partitions.size()) {
+			// all partitions - no need to filter
+		} else if (task_max - task_min == 1) {
+			filter = partitions[task_min];
+		} else {
+			vector<string> task_partitions(partitions.begin() + NumericCast<int64_t>(task_min),
+			                               partitions.begin() + NumericCast<int64_t>(task_max));
+			filter = "(" + StringUtil::Join(task_partitions, " OR ") + ")";
+		}
+		if (!filter.empty()) {
+			filter = "WHERE " + filter;
+		}
+	} else if (bind_data->pages_approx > 0) {
 		filter = StringUtil::Format("WHERE ctid BETWEEN '(%d,0)'::tid AND '(%d,0)'::tid", task_min, task_max);
 	}
 	if (!filter_string.empty()) {
@@ -275,20 +426,29 @@ static void PostgresInitInternal(ClientContext &context, const PostgresBindData
 	string query;
 	if (bind_data->table_name.empty()) {
 		D_ASSERT(!bind_data->sql.empty());
-		query = StringUtil::Format(R"(SELECT %s FROM (%s) AS __unnamed_subquery %s%s)", col_names, bind_data->sql,
-		                           filter, bind_data->limit);
+		query = StringUtil::Format(R"(SELECT %s FROM (%s) AS __unnamed_subquery %s%s%s%s)", col_names,
+		                           bind_data->sql, filter, bind_data->group_by, bind_data->order_by, bind_data->limit);
 
 	} else {
-		query = StringUtil::Format(R"(SELECT %s FROM %s.%s %s%s)", col_names,
+		query = StringUtil::Format(R"(SELECT %s FROM %s.%s %s%s%s%s)", col_names,
 		                           KeywordHelper::WriteQuoted(bind_data->schema_name, '"'),
-		                           KeywordHelper::WriteQuoted(bind_data->table_name, '"'), filter, bind_data->limit);
+		                           KeywordHelper::WriteQuoted(bind_data->table_name, '"'), filter, bind_data->group_by,
+		                           bind_data->order_by, bind_data->limit);
 	}
 	if (!bind_data->use_text_protocol) {
 		query = StringUtil::Format(R"(COPY (%s) TO STDOUT (FORMAT "binary");)", query);
 	} else {
 		query += ";";
 	}
-	lstate.sql = std::move(query);
+	return query;
+}
+
+static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data,
+                                 PostgresLocalState &lstate, const PostgresGlobalState &gstate, idx_t task_min,
+                                 idx_t task_max) {
+	lstate.exec = false;
+	lstate.done = false;
+	lstate.sql = PostgresGetTaskQuery(context, bind_data, lstate, gstate.partition_filters, task_min, task_max);
 }
 
 static idx_t PostgresMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
@@ -310,6 +470,61 @@ static void PostgresScanConnect(PostgresConnection &conn, string snapshot) {
 	}
 }
 
+static void PostgresGetPartitions(const PostgresBindData &bind_data, PostgresGlobalState &gstate) {
+	if (bind_data.partition_range_count == 0) {
+		gstate.partition_filters = bind_data.partition_filters;
+		return;
+	}
+	auto &column_name = bind_data.partition_range_column;
+	auto &min_value = bind_data.partition_range_min;
+	auto &max_value = bind_data.partition_range_max;
+	if (!min_value.IsNull() && !max_value.IsNull()) {
+		gstate.partition_filters = PostgresPartitioning::IntegerRangePartitions(
+		    column_name, min_value.GetValue<int64_t>(), max_value.GetValue<int64_t>(), bind_data.partition_range_count);
+		return;
+	}
+	// fetch the bounds of the partition column - this runs on the connection (and in the snapshot) of the scan
+	auto column = KeywordHelper::WriteQuoted(column_name, '"');
+	auto result = gstate.GetConnection().Query(StringUtil::Format(
+	    "SELECT MIN(%s)::BIGINT, MAX(%s)::BIGINT FROM (%s) AS __unnamed_subquery", column, column, bind_data.sql));
+	if (result->IsNull(0, 0) || result->IsNull(0, 1)) {
+		// no rows (or only NULL values) - nothing to split
+		gstate.partition_filters = PostgresPartitioning::RangePartitions(column_name, vector<string>());
+		return;
+	}
+	auto min = min_value.IsNull() ? result->GetInt64(0, 0) : min_value.GetValue<int64_t>();
+	auto max = max_value.IsNull() ? result->GetInt64(0, 1) : max_value.GetValue<int64_t>();
+	gstate.partition_filters =
+	    PostgresPartitioning::IntegerRangePartitions(column_name, min, max, bind_data.partition_range_count);
+}
+
+static void PostgresGetPageCount(const PostgresBindData &bind_data, PostgresGlobalState &gstate) {
+	if (bind_data.HasPartitions()) {
+		// every partition is a task
+		gstate.page_count = gstate.partition_filters.size();
+		return;
+	}
+	gstate.page_count = bind_data.pages_approx;
+	if (bind_data.pages_approx == 0 || bind_data.table_name.empty()) {
+		// not a ctid scan
+		return;
+	}
+	// relpages is only updated by VACUUM and ANALYZE - measure the actual size of the relation instead
+	auto table_name = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+	                  KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+	auto result = gstate.GetConnection().TryQuery(
+	    StringUtil::Format("SELECT pg_relation_size(to_regclass(%s)) / current_setting('block_size')::BIGINT",
+	                       KeywordHelper::WriteQuoted(table_name, '\'')));
+	if (!result || result->Count() != 1 || result->IsNull(0, 0)) {
+		return;
+	}
+	gstate.page_count = MaxValue<idx_t>(NumericCast<idx_t>(result->GetInt64(0, 0)), 1);
+	if (gstate.max_threads > 1) {
+		// the scan is parallel - base the number of threads on the actual size as well
+		gstate.max_threads = MaxValue<idx_t>(gstate.page_count / bind_data.pages_per_task, 1);
+	}
+}
+
 static unique_ptr<GlobalTableFunctionState> PostgresInitGlobalState(ClientContext &context,
                                                                     TableFunctionInitInput &input) {
 	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
@@ -327,74 +542,187 @@ static unique_ptr<GlobalTableFunctionState> PostgresInitGlobalState(ClientContex
 		}
 		result->SetConnection(std::move(con));
 	}
-	if (bind_data.requires_materialization) {
+	result->materialize = bind_data.requires_materialization;
+	if (!result->materialize) {
+		// we create a transaction here, and get the snapshot id to enable transaction-safe parallelism
+		PostgresGetSnapshot(context, bind_data.version, bind_data, *result);
+		// partitions that are scanned on connections of their own have to read through the same snapshot
+		bool requires_snapshot =
+		    bind_data.use_transaction_snapshot || (bind_data.HasPartitions() && result->max_threads > 1);
+		if (requires_snapshot && result->snapshot.empty()) {
+			// the transaction has written since the query was planned (or no snapshot can be exported) - its
+			// writes are not visible through a snapshot so we fall back to materializing the table over the
+			// connection of the transaction
+			result->materialize = true;
+			result->max_threads = 1;
+		}
+	}
+	if (result->materialize) {
 		// if requires_materialization is enabled we scan and materialize the table in its entirety up-front
 		vector<LogicalType> types;
 		for (auto column_id : input.column_ids) {
 			types.push_back(column_id == COLUMN_IDENTIFIER_ROW_ID ? LogicalType::BIGINT : bind_data.types[column_id]);
 		}
-		auto materialized = make_uniq<ColumnDataCollection>(Allocator::Get(context), types);
-		DataChunk scan_chunk;
-		scan_chunk.Initialize(Allocator::Get(context), types);
-
-		auto local_state = GetLocalState(context, input, *result);
-		auto &lstate = local_state->Cast<PostgresLocalState>();
-		ColumnDataAppendState append_state;
-		materialized->InitializeAppend(append_state);
-		while (true) {
-			scan_chunk.Reset();
-			lstate.ScanChunk(context, bind_data, *result, scan_chunk);
-			if (scan_chunk.size() == 0) {
-				break;
-			}
-			materialized->Append(append_state, scan_chunk);
+		// the table is materialized on a background thread into buffer-managed storage - rows are handed to the scan
+		// as soon as they have been read, and other uses of the connection wait until the table has been read
+		result->materialize_state = GetLocalState(context, input, *result);
+		auto &lstate = result->materialize_state->Cast<PostgresLocalState>();
+		auto &gstate = *result;
+		optional_ptr<PostgresTransaction> transaction;
+		if (pg_catalog) {
+			transaction = PostgresTransaction::Get(context, *pg_catalog);
 		}
-		result->collection = std::move(materialized);
-		result->collection->InitializeScan(result->scan_state);
+		result->materializer = make_uniq<PostgresScanMaterializer>(
+		    context, std::move(types),
+		    [&bind_data, &gstate, &lstate](ClientContext &context, DataChunk &output) {
+			    lstate.ScanChunk(context, bind_data, gstate, output);
+		    },
+		    transaction);
 	} else {
-		// we create a transaction here, and get the snapshot id to enable transaction-safe parallelism
-		PostgresGetSnapshot(bind_data.version, bind_data, *result);
+		PostgresGetPartitions(bind_data, *result);
+		PostgresGetPageCount(bind_data, *result);
 	}
 	return std::move(result);
 }
 
+static idx_t PostgresTaskPages(const PostgresBindData &bind_data, const PostgresGlobalState &gstate) {
+	// once we know how fast pages are scanned we size tasks to take roughly this long
+	constexpr static double TARGET_TASK_SECONDS = 0.5;
+	// adaptive task sizes stay within a factor of MAX_TASK_SCALE of pg_pages_per_task
+	constexpr static idx_t MAX_TASK_SCALE = 8;
+
+	idx_t base_pages = MinValue<idx_t>(bind_data.pages_per_task, POSTGRES_TID_MAX);
+	idx_t task_pages = base_pages;
+	if (gstate.seconds_per_page > 0) {
+		auto adaptive_pages = TARGET_TASK_SECONDS / gstate.seconds_per_page;
+		auto min_pages = MaxValue<idx_t>(base_pages / MAX_TASK_SCALE, 1);
+		auto max_pages = base_pages * MAX_TASK_SCALE;
+		if (adaptive_pages <= double(min_pages)) {
+			task_pages = min_pages;
+		} else if (adaptive_pages >= double(max_pages)) {
+			task_pages = max_pages;
+		} else {
+			task_pages = idx_t(adaptive_pages);
+		}
+	}
+	// guided scheduling: tasks shrink as the end of the relation approaches so that all threads finish together
+	// instead of one thread scanning a large final range on its own
+	auto remaining_pages = gstate.page_count - gstate.page_idx;
+	auto guided_pages = remaining_pages / (2 * MaxValue<idx_t>(gstate.max_threads, 1));
+	task_pages = MinValue<idx_t>(task_pages, MaxValue<idx_t>(guided_pages, 1));
+	return task_pages;
+}
+
+static bool PostgresNextPageRange(const PostgresBindData &bind_data, PostgresGlobalState &gstate, idx_t &page_min,
+                                  idx_t &page_max) {
+	if (gstate.page_idx >= gstate.page_count) {
+		return false;
+	}
+	if (bind_data.max_rows > 0 && gstate.scanned_rows >= bind_data.max_rows) {
+		// the LIMIT has been reached - no need to scan the remaining pages
+		return false;
+	}
+	if (bind_data.HasPartitions()) {
+		// a single partition
+		page_min = gstate.page_idx;
+		page_max = page_min + 1;
+		gstate.page_idx = page_max;
+		return true;
+	}
+	page_min = gstate.page_idx;
+	page_max = gstate.page_idx + PostgresTaskPages(bind_data, gstate);
+	if (page_max >= gstate.page_count || page_max > POSTGRES_TID_MAX) {
+		// pages might have been added since we measured the relation, so make the last task open-ended
+		page_max = POSTGRES_TID_MAX;
+	}
+	gstate.page_idx = page_max;
+	return true;
+}
+
+void PostgresGlobalState::FinishTask(idx_t task_pages, double seconds) {
+	if (task_pages == 0) {
+		return;
+	}
+	lock_guard<mutex> parallel_lock(lock);
+	auto observed = seconds / double(task_pages);
+	if (seconds_per_page <= 0) {
+		seconds_per_page = observed;
+	} else {
+		seconds_per_page = (seconds_per_page + observed) / 2;
+	}
+}
+
+static idx_t PostgresTaskPageCount(const PostgresGlobalState &gstate, idx_t page_min, idx_t page_max) {
+	// the last task is open-ended - count only the pages that were there when we measured the relation
+	auto page_end = MinValue<idx_t>(page_max, gstate.page_count);
+	return page_end > page_min ? page_end - page_min : 0;
+}
+
+static void PostgresStartTask(PostgresLocalState &lstate, idx_t task_pages) {
+	lstate.task_pages = task_pages;
+	lstate.task_timer.Start();
+}
+
 static bool PostgresParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
                                       PostgresLocalState &lstate, PostgresGlobalState &gstate) {
 	D_ASSERT(bind_data_p);
 	auto bind_data = (const PostgresBindData *)bind_data_p;
 
+	if (lstate.prefetched_task) {
+		// the COPY of this task has already been issued by the reader
+		lstate.prefetched_task = false;
+		lstate.batch_idx = lstate.prefetched_batch_idx;
+		lstate.exec = true;
+		lstate.done = false;
+		PostgresStartTask(lstate, lstate.prefetched_task_pages);
+		return true;
+	}
 	lock_guard<mutex> parallel_lock(gstate.lock);
 	lstate.batch_idx = gstate.batch_idx++;
-	if (gstate.page_idx < bind_data->pages_approx) {
-		auto page_max = gstate.page_idx + bind_data->pages_per_task;
-		if (page_max >= bind_data->pages_approx || page_max > POSTGRES_TID_MAX) {
-			// the relpages entry is not the real max, so make the last task bigger
-			page_max = POSTGRES_TID_MAX;
-		}
-
-		PostgresInitInternal(context, bind_data, lstate, gstate.page_idx, page_max);
-		gstate.page_idx = page_max;
+	idx_t page_min, page_max;
+	if (PostgresNextPageRange(*bind_data, gstate, page_min, page_max)) {
+		PostgresInitInternal(context, bind_data, lstate, gstate, page_min, page_max);
+		PostgresStartTask(lstate, PostgresTaskPageCount(gstate, page_min, page_max));
 		return true;
 	}
 	lstate.done = true;
 	return false;
 }
 
+static void PostgresPrefetchNextTask(ClientContext &context, const PostgresBindData &bind_data,
+                                     PostgresLocalState &lstate, PostgresGlobalState &gstate) {
+	idx_t page_min, page_max;
+	{
+		lock_guard<mutex> parallel_lock(gstate.lock);
+		if (!PostgresNextPageRange(bind_data, gstate, page_min, page_max)) {
+			lstate.prefetch_exhausted = true;
+			return;
+		}
+		lstate.prefetched_batch_idx = gstate.batch_idx++;
+		lstate.prefetched_task_pages = PostgresTaskPageCount(gstate, page_min, page_max);
+	}
+	// hand the COPY of the next task to the reader so it is issued as soon as the current COPY has been received
+	lstate.reader->BeginCopy(
+	    PostgresGetTaskQuery(context, &bind_data, lstate, gstate.partition_filters, page_min, page_max));
+	lstate.prefetched_task = true;
+}
+
 bool PostgresGlobalState::TryOpenNewConnection(ClientContext &context, PostgresLocalState &lstate,
                                                const PostgresBindData &bind_data) {
 	auto pg_catalog = bind_data.GetCatalog();
 	{
 		lock_guard<mutex> parallel_lock(lock);
 		if (!used_main_thread) {
-			if (bind_data.can_use_main_thread) {
+			used_main_thread = true;
+			if (bind_data.can_use_main_thread || materialize) {
 				lstate.connection = PostgresConnection(GetConnection().GetConnection());
-			} else {
-				// we cannot use the main thread but we haven't initiated ANY scan yet
-				// we HAVE to open a new connection
-				lstate.pool_connection = pg_catalog->GetConnectionPool().ForceGetConnection();
-				lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+				return true;
 			}
-			used_main_thread = true;
+			// we cannot use the main thread but we haven't initiated ANY scan yet
+			// we HAVE to open a new connection
+			lstate.pool_connection = pg_catalog->GetConnectionPool().ForceGetConnection();
+			lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+			PostgresScanConnect(lstate.connection, snapshot);
 			return true;
 		}
 	}
@@ -416,7 +744,7 @@ static unique_ptr<LocalTableFunctionState> GetLocalState(ClientContext &context,
 	auto &bind_data = (PostgresBindData &)*input.bind_data;
 
 	auto local_state = make_uniq<PostgresLocalState>();
-	if (gstate.collection) {
+	if (gstate.materializer) {
 		return std::move(local_state);
 	}
 	local_state->column_ids = input.column_ids;
@@ -427,8 +755,8 @@ static unique_ptr<LocalTableFunctionState> GetLocalState(ClientContext &context,
 		local_state->no_connection = true;
 		return std::move(local_state);
 	}
-	if (bind_data.pages_approx == 0 || bind_data.requires_materialization) {
-		PostgresInitInternal(context, &bind_data, *local_state, 0, POSTGRES_TID_MAX);
+	if (!bind_data.HasTasks() || gstate.materialize) {
+		PostgresInitInternal(context, &bind_data, *local_state, gstate, 0, POSTGRES_TID_MAX);
 		gstate.page_idx = POSTGRES_TID_MAX;
 	} else if (!PostgresParallelStateNext(context, input.bind_data.get(), *local_state, gstate)) {
 		local_state->done = true;
@@ -461,8 +789,16 @@ void PostgresLocalState::ScanChunk(ClientContext &context, const PostgresBindDat
 			reader->BeginCopy(sql);
 			exec = true;
 		}
+		if (!prefetched_task && !prefetch_exhausted && reader->SupportsPrefetch()) {
+			PostgresPrefetchNextTask(context, bind_data, *this, gstate);
+		}
 		auto read_result = reader->Read(output);
 		if (read_result == PostgresReadResult::FINISHED) {
+			if (task_pages > 0) {
+				task_timer.End();
+				gstate.FinishTask(task_pages, task_timer.Elapsed());
+				task_pages = 0;
+			}
 			done = true;
 			continue;
 		}
@@ -476,8 +812,8 @@ static void PostgresScan(ClientContext &context, TableFunctionInput &data, DataC
 	auto &bind_data = data.bind_data->Cast<PostgresBindData>();
 	auto &gstate = data.global_state->Cast<PostgresGlobalState>();
 
-	if (gstate.collection) {
-		gstate.collection->Scan(gstate.scan_state, output);
+	if (gstate.materializer) {
+		gstate.materializer->Scan(output);
 		return;
 	}
 	auto &local_state = data.local_state->Cast<PostgresLocalState>();
@@ -485,6 +821,9 @@ static void PostgresScan(ClientContext &context, TableFunctionInput &data, DataC
 		return;
 	}
 	local_state.ScanChunk(context, bind_data, gstate, output);
+	if (bind_data.max_rows > 0) {
+		gstate.scanned_rows += output.size();
+	}
 }
 
 static OperatorPartitionData PostgresGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
@@ -501,11 +840,19 @@ static InsertionOrderPreservingMap<string> PostgresScanToString(TableFunctionToS
 	InsertionOrderPreservingMap<string> result;
 	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
 	result["Table"] = bind_data.table_name;
+	if (!bind_data.source_filter.empty()) {
+		result["Filters"] = bind_data.source_filter;
+	}
 	return result;
 }
 
 unique_ptr<NodeStatistics> PostgresScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	if (bind_data.rows_approx > 0) {
+		// use the row estimate of Postgres (reltuples or the estimate of the query plan)
+		return make_uniq<NodeStatistics>(bind_data.rows_approx);
+	}
+	// estimate the row count from the number of pages
 	// see https://www.postgresql.org/docs/current/storage-page-layout.html
 	// pages are 8KB
 	// every page has ~24 bytes of overhead
@@ -520,13 +867,22 @@ unique_ptr<NodeStatistics> PostgresScanCardinality(ClientContext &context, const
 	return make_uniq<NodeStatistics>(estimated_cardinality);
 }
 
+static unique_ptr<BaseStatistics> PostgresScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                         column_t column_id) {
+	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	auto table = bind_data.GetTable();
+	if (!table) {
+		return nullptr;
+	}
+	return table->GetStatistics(context, column_id);
+}
+
 double PostgresScanProgress(ClientContext &context, const FunctionData *bind_data_p,
                             const GlobalTableFunctionState *global_state) {
-	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
 	auto &gstate = global_state->Cast<PostgresGlobalState>();
 
 	lock_guard<mutex> parallel_lock(gstate.lock);
-	double progress = 100 * double(gstate.page_idx) / double(bind_data.pages_approx);
+	double progress = 100 * double(gstate.page_idx) / double(gstate.page_count);
 	return MinValue<double>(100, progress);
 }
 
@@ -539,6 +895,110 @@ static unique_ptr<FunctionData> PostgresScanDeserialize(Deserializer &deserializ
 	throw NotImplementedException("PostgresScanDeserialize");
 }
 
+//! Whether or not DuckDB turns a filter into table filters by itself - i.e. if it only compares a single column with
+//! constants
+static bool IsColumnFilter(const Expression &expr, optional_idx &column_index) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COLUMN_REF: {
+		auto index = expr.Cast<BoundColumnRefExpression>().binding.column_index;
+		if (column_index.IsValid() && column_index.GetIndex() != index) {
+			return false;
+		}
+		column_index = index;
+		return true;
+	}
+	case ExpressionClass::BOUND_CONSTANT:
+		return true;
+	case ExpressionClass::BOUND_COMPARISON: {
+		auto &comparison = expr.Cast<BoundComparisonExpression>();
+		return IsColumnFilter(*comparison.left, column_index) && IsColumnFilter(*comparison.right, column_index);
+	}
+	case ExpressionClass::BOUND_BETWEEN: {
+		auto &between = expr.Cast<BoundBetweenExpression>();
+		return IsColumnFilter(*between.input, column_index) && IsColumnFilter(*between.lower, column_index) &&
+		       IsColumnFilter(*between.upper, column_index);
+	}
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		for (auto &child : expr.Cast<BoundConjunctionExpression>().children) {
+			if (!IsColumnFilter(*child, column_index)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	case ExpressionClass::BOUND_OPERATOR: {
+		switch (expr.GetExpressionType()) {
+		case ExpressionType::OPERATOR_IS_NULL:
+		case ExpressionType::OPERATOR_IS_NOT_NULL:
+		case ExpressionType::COMPARE_IN:
+			break;
+		default:
+			return false;
+		}
+		for (auto &child : expr.Cast<BoundOperatorExpression>().children) {
+			if (!IsColumnFilter(*child, column_index)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//! Push the filters that DuckDB cannot turn into table filters (e.g. LIKE, functions or predicates over multiple
+//! columns) into the scan - filters that Postgres might not evaluate in the same way are left to DuckDB
+static bool CanPushdownExpressions(const LogicalGet &get, const PostgresBindData &bind_data) {
+	return get.function.filter_pushdown && bind_data.version.type_v != PostgresInstanceType::REDSHIFT &&
+	       bind_data.column_expressions.empty();
+}
+
+static vector<PostgresFilterColumn> GetFilterColumns(const LogicalGet &get, const PostgresBindData &bind_data) {
+	vector<PostgresFilterColumn> columns;
+	for (auto &column_id : get.GetColumnIds()) {
+		auto index = column_id.GetPrimaryIndex();
+		if (IsVirtualColumn(index)) {
+			columns.emplace_back(string(), PostgresType());
+			continue;
+		}
+		columns.emplace_back(KeywordHelper::WriteQuoted(bind_data.names[index], '"'), bind_data.postgres_types[index]);
+	}
+	return columns;
+}
+
+static void PostgresPushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+                                          vector<unique_ptr<Expression>> &filters) {
+	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	if (!CanPushdownExpressions(get, bind_data)) {
+		return;
+	}
+	auto columns = GetFilterColumns(get, bind_data);
+	vector<unique_ptr<Expression>> remaining_filters;
+	for (auto &filter : filters) {
+		optional_idx column_index;
+		if (!IsColumnFilter(*filter, column_index)) {
+			auto filter_string = PostgresFilterPushdown::TransformExpression(*filter, columns);
+			if (!filter_string.empty()) {
+				bind_data.AddSourceFilter(filter_string);
+				continue;
+			}
+		}
+		remaining_filters.push_back(std::move(filter));
+	}
+	filters = std::move(remaining_filters);
+}
+
+static bool PostgresPushdownExpression(ClientContext &context, const LogicalGet &get, Expression &filter) {
+	// only expressions that can be evaluated by Postgres become expression table filters - the rest stay in DuckDB
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!CanPushdownExpressions(get, bind_data)) {
+		return false;
+	}
+	auto columns = GetFilterColumns(get, bind_data);
+	return !PostgresFilterPushdown::TransformExpression(filter, columns).empty();
+}
+
 static BindInfo PostgresGetBindInfo(const optional_ptr<FunctionData> bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
 	auto table = bind_data.GetTable();
@@ -555,8 +1015,10 @@ PostgresScanFunction::PostgresScanFunction()
 	deserialize = PostgresScanDeserialize;
 	get_partition_data = PostgresGetPartitionData;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	get_bind_info = PostgresGetBindInfo;
+	pushdown_complex_filter = PostgresPushdownComplexFilter;
 	projection_pushdown = true;
 	global_initialization = TableFunctionInitialization::INITIALIZE_ON_SCHEDULE;
 }
@@ -569,8 +1031,11 @@ PostgresScanFunctionFilterPushdown::PostgresScanFunctionFilterPushdown()
 	deserialize = PostgresScanDeserialize;
 	get_partition_data = PostgresGetPartitionData;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	get_bind_info = PostgresGetBindInfo;
+	pushdown_complex_filter = PostgresPushdownComplexFilter;
+	pushdown_expression = PostgresPushdownExpression;
 	projection_pushdown = true;
 	filter_pushdown = true;
 	global_initialization = TableFunctionInitialization::INITIALIZE_ON_SCHEDULE;
@@ -1,6 +1,8 @@
 #include "postgres_text_reader.hpp"
 #include "postgres_scanner.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/types/blob.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 namespace duckdb {
 
@@ -14,29 +16,91 @@ PostgresTextReader::~PostgresTextReader() {
 }
 
 void PostgresTextReader::BeginCopy(const string &sql) {
-	result = con.Query(sql);
+	Reset();
+	auto query = sql;
+	StringUtil::RTrim(query);
+	if (StringUtil::EndsWith(query, ";")) {
+		query.pop_back();
+	}
+	if (!TryDeclareCursor(query)) {
+		// the entire result set is buffered by libpq
+		SetResult(con.Query(sql));
+	}
+}
+
+bool PostgresTextReader::TryDeclareCursor(const string &query) {
+	static atomic<idx_t> cursor_count {0};
+
+	if (bind_data.text_fetch_size == 0) {
+		return false;
+	}
+	string begin;
+	switch (PQtransactionStatus(con.GetConn())) {
+	case PQTRANS_INTRANS:
+		break;
+	case PQTRANS_IDLE:
+		// cursors only live within a transaction - outside of one we start a transaction on the connection of the
+		// scan that is committed once the cursor is closed (a WITH HOLD cursor would be materialized at commit)
+		begin = "BEGIN; ";
+		break;
+	default:
+		return false;
+	}
+	cursor_name = StringUtil::Format("__duckdb_text_cursor_%llu", cursor_count++);
+	cursor_exhausted = false;
+	cursor_transaction = !begin.empty();
+	// declare the cursor and fetch the first batch in a single round-trip
+	SetResult(con.Query(StringUtil::Format("%sDECLARE %s CURSOR FOR %s; FETCH FORWARD %llu FROM %s", begin,
+	                                       cursor_name, query, bind_data.text_fetch_size, cursor_name)));
+	cursor_exhausted = result->Count() < bind_data.text_fetch_size;
+	return true;
+}
+
+bool PostgresTextReader::FetchNextBatch() {
+	if (cursor_exhausted) {
+		return false;
+	}
+	SetResult(con.Query(StringUtil::Format("FETCH FORWARD %llu FROM %s", bind_data.text_fetch_size, cursor_name)));
+	cursor_exhausted = result->Count() < bind_data.text_fetch_size;
+	return result->Count() > 0;
+}
+
+void PostgresTextReader::SetResult(unique_ptr<PostgresResult> new_result) {
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	result.reset();
+	buffer_manager.FreeReservedMemory(reserved_memory);
+	reserved_memory = 0;
 	row_offset = 0;
+	if (!new_result) {
+		return;
+	}
+	auto result_size = PQresultMemorySize(new_result->res);
+	buffer_manager.ReserveMemory(result_size);
+	reserved_memory = result_size;
+	result = std::move(new_result);
 }
 
 struct PostgresListParser {
+	//! Empty elements do not occur in arrays - NULL elements are written as NULL
+	static constexpr const bool EMPTY_ELEMENTS = false;
+
 	PostgresListParser() : capacity(STANDARD_VECTOR_SIZE), size(0), vector(LogicalType::VARCHAR, capacity) {
 	}
 
 	void Initialize() {
 	}
 
-	void AddString(const string &str, bool &quoted) {
+	void AddString(string_t str, bool quoted) {
 		if (size >= capacity) {
 			vector.Resize(capacity, capacity * 2);
 			capacity *= 2;
 		}
-		if (!quoted && str == "NULL") {
+		if (!quoted && str.GetSize() == 4 && memcmp(str.GetData(), "NULL", 4) == 0) {
 			FlatVector::SetNull(vector, size, true);
 		} else {
 			FlatVector::GetData<string_t>(vector)[size] = StringVector::AddStringOrBlob(vector, str);
 		}
 		size++;
-		quoted = false;
 	}
 
 	void Finish() {
@@ -48,6 +112,8 @@ struct PostgresListParser {
 };
 
 struct PostgresStructParser {
+	//! NULL fields of composites are written as empty elements - a field that contains "NULL" is a string
+	static constexpr const bool EMPTY_ELEMENTS = true;
 	PostgresStructParser(ClientContext &context, idx_t child_count, idx_t row_count) {
 		vector<LogicalType> child_varchar_types;
 		for (idx_t c = 0; c < child_count; c++) {
@@ -61,13 +127,13 @@ struct PostgresStructParser {
 		column_offset = 0;
 	}
 
-	void AddString(const string &str, bool &quoted) {
+	void AddString(string_t str, bool quoted) {
 		if (column_offset >= data.ColumnCount()) {
-			throw InvalidInputException("Too many columns in data for parsing struct - string %s - expected %d", str,
-			                            data.ColumnCount());
+			throw InvalidInputException("Too many columns in data for parsing struct - string %s - expected %d",
+			                            str.GetString(), data.ColumnCount());
 		}
 		auto &col = data.data[column_offset];
-		if (!quoted && str == "NULL") {
+		if (!quoted && str.GetSize() == 0) {
 			FlatVector::SetNull(col, row_offset, true);
 		} else {
 			FlatVector::GetData<string_t>(col)[row_offset] = StringVector::AddStringOrBlob(col, str);
@@ -88,24 +154,79 @@ struct PostgresStructParser {
 	idx_t row_offset = 0;
 };
 
-struct PostgresCTIDParser {
-	PostgresCTIDParser() {
+//! Classifies the characters of nested values - regular characters can be skipped without further checks
+struct PostgresNestedCharTable {
+	static constexpr const uint8_t DELIMITER = 1;
+	static constexpr const uint8_t QUOTE = 2;
+	static constexpr const uint8_t ESCAPE = 4;
+
+	PostgresNestedCharTable() {
+		memset(classes, 0, sizeof(classes));
+		for (auto c : {',', '{', '}', '(', ')'}) {
+			classes[static_cast<uint8_t>(c)] = DELIMITER;
+		}
+		classes[static_cast<uint8_t>('"')] = QUOTE;
+		classes[static_cast<uint8_t>('\\')] = ESCAPE;
 	}
 
-	void Initialize() {
+	//! Whether or not the character is part of an unquoted element (i.e. no delimiter or quote)
+	bool IsUnquoted(char c) const {
+		return (classes[static_cast<uint8_t>(c)] & (DELIMITER | QUOTE)) == 0;
+	}
+	//! Whether or not the character is copied as-is within a quoted element (i.e. no quote or escape)
+	bool IsQuoted(char c) const {
+		return (classes[static_cast<uint8_t>(c)] & (QUOTE | ESCAPE)) == 0;
 	}
 
-	void AddString(const string &str, bool &quoted) {
-		values.push_back(StringUtil::ToUnsigned(str));
+	uint8_t classes[256];
+};
+
+static const PostgresNestedCharTable NESTED_CHAR_TABLE;
+
+//! An element of a nested value - the element points directly into the value unless it contains escapes, in which
+//! case the unescaped element is copied into a buffer that is re-used between elements
+struct PostgresNestedElement {
+	explicit PostgresNestedElement(string &buffer) : buffer(buffer) {
 	}
 
-	void Finish() {
-		if (values.size() != 2) {
-			throw InvalidInputException("CTID mismatch - expected (page_index, row_in_page)");
+	void Append(const char *data, idx_t len) {
+		if (len == 0) {
+			return;
 		}
+		if (!copied) {
+			if (span_len == 0) {
+				span_start = data;
+				span_len = len;
+				return;
+			}
+			if (data == span_start + span_len) {
+				span_len += len;
+				return;
+			}
+			buffer.assign(span_start, span_len);
+			copied = true;
+		}
+		buffer.append(data, len);
+	}
+	bool Empty() const {
+		return copied ? buffer.empty() : span_len == 0;
+	}
+	string_t Get() const {
+		return copied ? string_t(buffer.c_str(), UnsafeNumericCast<uint32_t>(buffer.size()))
+		              : string_t(span_start, UnsafeNumericCast<uint32_t>(span_len));
+	}
+	void Reset() {
+		span_start = "";
+		span_len = 0;
+		copied = false;
+		quoted = false;
 	}
 
-	vector<idx_t> values;
+	string &buffer;
+	const char *span_start = "";
+	idx_t span_len = 0;
+	bool copied = false;
+	bool quoted = false;
 };
 
 template <class T>
@@ -117,39 +238,70 @@ void ParsePostgresNested(T &parser, string_t list, char start, char end) {
 		                            string(1, end), list.GetString());
 	}
 	parser.Initialize();
-	bool quoted = false;
-	bool was_quoted = false;
+	string buffer;
+	PostgresNestedElement element(buffer);
 	vector<char> delims;
-	string current_string;
-	for (idx_t i = 1; i < size - 1; i++) {
-		auto c = str[i];
-		if (quoted) {
-			switch (c) {
-			case '"':
-				quoted = false;
-				break;
-			case '\\':
-				// escape - directly add the next character to the string
-				if (i + 1 < size) {
-					current_string += str[i + 1];
+	idx_t list_end = size - 1;
+	idx_t pos = 1;
+	while (pos < list_end) {
+		auto c = str[pos];
+		if (c == ',' && delims.empty()) {
+			// next element
+			if (T::EMPTY_ELEMENTS || !element.Empty() || element.quoted) {
+				parser.AddString(element.Get(), element.quoted);
+			}
+			element.Reset();
+			pos++;
+			continue;
+		}
+		if (c == '"') {
+			auto quote_start = pos++;
+			if (!delims.empty()) {
+				// quoted strings in a nested value are kept as-is - they are unescaped when the value is parsed
+				for (; pos < list_end && str[pos] != '"'; pos++) {
+					if (str[pos] == '\\') {
+						pos++;
+					}
 				}
-				// skip the next character
-				i++;
-				break;
-			default:
-				current_string += c;
-				break;
+				pos = MinValue<idx_t>(pos + 1, list_end);
+				element.Append(str + quote_start, pos - quote_start);
+				continue;
+			}
+			element.quoted = true;
+			while (pos < list_end) {
+				// skip over the run of characters that do not need to be unescaped
+				auto run_start = pos;
+				while (pos < list_end && NESTED_CHAR_TABLE.IsQuoted(str[pos])) {
+					pos++;
+				}
+				element.Append(str + run_start, pos - run_start);
+				if (pos >= list_end) {
+					break;
+				}
+				if (str[pos] == '"') {
+					if (pos + 1 < list_end && str[pos + 1] == '"') {
+						// composites escape quotes by doubling them
+						element.Append(str + pos, 1);
+						pos += 2;
+						continue;
+					}
+					pos++;
+					break;
+				}
+				// escape - directly add the next character to the element
+				if (pos + 1 < size) {
+					element.Append(str + pos + 1, 1);
+				}
+				pos += 2;
 			}
 			continue;
 		}
 		switch (c) {
 		case '{':
 			delims.push_back('}');
-			current_string += c;
 			break;
 		case '(':
 			delims.push_back(')');
-			current_string += c;
 			break;
 		case '}':
 		case ')':
@@ -157,30 +309,20 @@ void ParsePostgresNested(T &parser, string_t list, char start, char end) {
 				throw InvalidInputException("Failed to convert list %s - mismatch in brackets", list.GetString());
 			}
 			delims.pop_back();
-			current_string += c;
-			break;
-		case '"':
-			quoted = true;
-			was_quoted = true;
-			break;
-		case ',':
-			if (!delims.empty()) {
-				// in a nested struct
-				current_string += c;
-				break;
-			}
-			// next element
-			if (!current_string.empty() || was_quoted) {
-				parser.AddString(current_string, was_quoted);
-			}
-			current_string = string();
 			break;
 		default:
-			current_string += c;
+			break;
+		}
+		// add the run of characters up until the next delimiter or quote
+		auto run_start = pos++;
+		while (pos < list_end && NESTED_CHAR_TABLE.IsUnquoted(str[pos])) {
+			pos++;
 		}
+		element.Append(str + run_start, pos - run_start);
 	}
-	if (!current_string.empty() || was_quoted) {
-		parser.AddString(current_string, was_quoted);
+	// the final element of a composite is always present - "()" is a composite with a single NULL field
+	if (T::EMPTY_ELEMENTS || !element.Empty() || element.quoted) {
+		parser.AddString(element.Get(), element.quoted);
 	}
 	parser.Finish();
 }
@@ -193,8 +335,81 @@ void ParsePostgresStruct(PostgresStructParser &struct_parser, string_t list) {
 	ParsePostgresNested(struct_parser, list, '(', ')');
 }
 
-void ParsePostgresCTID(PostgresCTIDParser &ctid_parser, string_t list) {
-	ParsePostgresNested(ctid_parser, list, '(', ')');
+//! Parse the digits of a ctid component, advancing the position past them
+static idx_t ParsePostgresCTIDComponent(const char *str, idx_t &pos, idx_t end) {
+	idx_t result = 0;
+	auto start = pos;
+	for (; pos < end && StringUtil::CharacterIsDigit(str[pos]); pos++) {
+		result = result * 10 + idx_t(str[pos] - '0');
+	}
+	if (pos == start || pos - start > 10) {
+		throw InvalidInputException("CTID mismatch - expected (page_index, row_in_page)");
+	}
+	return result;
+}
+
+static int64_t ParsePostgresCTID(string_t ctid) {
+	// ctids have the format (page_index,row_in_page)
+	auto str = ctid.GetData();
+	auto size = ctid.GetSize();
+	if (size < 5 || str[0] != '(' || str[size - 1] != ')') {
+		throw InvalidInputException("CTID mismatch - expected (page_index, row_in_page)");
+	}
+	idx_t pos = 1;
+	auto page_index = ParsePostgresCTIDComponent(str, pos, size - 1);
+	if (str[pos] != ',') {
+		throw InvalidInputException("CTID mismatch - expected (page_index, row_in_page)");
+	}
+	pos++;
+	auto row_in_page = ParsePostgresCTIDComponent(str, pos, size - 1);
+	if (pos != size - 1) {
+		throw InvalidInputException("CTID mismatch - expected (page_index, row_in_page)");
+	}
+	return NumericCast<int64_t>((page_index << 16LL) + row_in_page);
+}
+
+//! Maps a hexadecimal digit to its value, or to INVALID_HEX_DIGIT
+static constexpr const uint8_t INVALID_HEX_DIGIT = 0xFF;
+
+struct PostgresHexTable {
+	PostgresHexTable() {
+		memset(values, INVALID_HEX_DIGIT, sizeof(values));
+		for (uint8_t c = 0; c < 10; c++) {
+			values['0' + c] = c;
+		}
+		for (uint8_t c = 0; c < 6; c++) {
+			values['a' + c] = 10 + c;
+			values['A' + c] = 10 + c;
+		}
+	}
+
+	uint8_t values[256];
+};
+
+static const PostgresHexTable HEX_TABLE;
+
+//! Decode hexadecimal digits into bytes - returns false if the input contains a character that is not a hex digit
+static bool DecodePostgresHex(const char *input, idx_t byte_count, data_ptr_t output) {
+	auto hex = reinterpret_cast<const uint8_t *>(input);
+	uint8_t invalid = 0;
+	idx_t i = 0;
+	// decode four bytes per iteration and only check for invalid digits at the end
+	for (; i + 4 <= byte_count; i += 4) {
+		for (idx_t k = 0; k < 4; k++) {
+			auto high = HEX_TABLE.values[hex[2 * (i + k)]];
+			auto low = HEX_TABLE.values[hex[2 * (i + k) + 1]];
+			invalid |= high | low;
+			output[i + k] = static_cast<data_t>(((high & 0x0F) << 4) | (low & 0x0F));
+		}
+	}
+	for (; i < byte_count; i++) {
+		auto high = HEX_TABLE.values[hex[2 * i]];
+		auto low = HEX_TABLE.values[hex[2 * i + 1]];
+		invalid |= high | low;
+		output[i] = static_cast<data_t>(((high & 0x0F) << 4) | (low & 0x0F));
+	}
+	// valid digits are smaller than 16 - INVALID_HEX_DIGIT sets the high bits
+	return (invalid & 0xF0) == 0;
 }
 
 void PostgresTextReader::ConvertList(Vector &source, Vector &target, const PostgresType &postgres_type, idx_t count) {
@@ -263,16 +478,12 @@ void PostgresTextReader::ConvertCTID(Vector &source, Vector &target, idx_t count
 			FlatVector::SetNull(target, i, true);
 			continue;
 		}
-		PostgresCTIDParser ctid_parser;
-		ParsePostgresCTID(ctid_parser, strings[i]);
-		auto page_index = ctid_parser.values[0];
-		auto row_in_page = ctid_parser.values[1];
-		result[i] = NumericCast<int64_t>((page_index << 16LL) + row_in_page);
+		result[i] = ParsePostgresCTID(strings[i]);
 	}
 }
 
 void PostgresTextReader::ConvertBlob(Vector &source, Vector &target, idx_t count) {
-	// ctids have the format (page_index, row_in_page)
+	// blobs have the format \xAABB...
 	UnifiedVectorFormat vdata;
 	source.ToUnifiedFormat(count, vdata);
 	auto strings = UnifiedVectorFormat::GetData<string_t>(vdata);
@@ -293,13 +504,13 @@ void PostgresTextReader::ConvertBlob(Vector &source, Vector &target, idx_t count
 		if (size % 2 != 0) {
 			throw InvalidInputException("Blob size must be modulo 2 (\\xAA)");
 		}
-		string result_blob;
-		for (idx_t i = 2; i < size; i += 2) {
-			int byte_a = Blob::HEX_MAP[static_cast<uint8_t>(str[i])];
-			int byte_b = Blob::HEX_MAP[static_cast<uint8_t>(str[i + 1])];
-			result_blob += UnsafeNumericCast<data_t>((byte_a << 4) + byte_b);
+		// decode directly into the string of the result vector
+		auto byte_count = (size - 2) / 2;
+		result[i] = StringVector::EmptyString(target, byte_count);
+		if (!DecodePostgresHex(str + 2, byte_count, data_ptr_cast(result[i].GetDataWriteable()))) {
+			throw InvalidInputException("Incorrect blob format - invalid hex digit in blob");
 		}
-		result[i] = StringVector::AddStringOrBlob(target, result_blob);
+		result[i].Finalize();
 	}
 }
 
@@ -339,7 +550,12 @@ PostgresReadResult PostgresTextReader::Read(DataChunk &output) {
 		scan_chunk.Initialize(context, types);
 	}
 	scan_chunk.Reset();
-	for (; scan_chunk.size() < STANDARD_VECTOR_SIZE && row_offset < result->Count(); row_offset++) {
+	for (; scan_chunk.size() < STANDARD_VECTOR_SIZE; row_offset++) {
+		if (row_offset >= result->Count()) {
+			if (!FetchNextBatch()) {
+				break;
+			}
+		}
 		idx_t output_offset = scan_chunk.size();
 		for (idx_t output_idx = 0; output_idx < output.ColumnCount(); output_idx++) {
 			auto col_idx = column_ids[output_idx];
@@ -366,7 +582,7 @@ PostgresReadResult PostgresTextReader::Read(DataChunk &output) {
 	}
 	output.SetCardinality(scan_chunk.size());
 
-	bool finished = row_offset >= result->Count();
+	bool finished = row_offset >= result->Count() && cursor_exhausted;
 	if (finished) {
 		// The result set is fully consumed. Reset immediately to free the PGresult.
 		Reset();
@@ -376,8 +592,18 @@ PostgresReadResult PostgresTextReader::Read(DataChunk &output) {
 }
 
 void PostgresTextReader::Reset() {
-	result.reset();
-	row_offset = 0;
+	if (!cursor_name.empty()) {
+		// the cursor might not have been exhausted - e.g. if the scan was stopped early
+		con.TryQuery("CLOSE " + cursor_name);
+		cursor_name = string();
+	}
+	if (cursor_transaction) {
+		// end the transaction that was started for the cursor - this also ends it if a statement has failed
+		con.TryQuery("COMMIT");
+		cursor_transaction = false;
+	}
+	cursor_exhausted = true;
+	SetResult(nullptr);
 }
 
 } // namespace duckdb
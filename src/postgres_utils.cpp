@@ -113,6 +113,10 @@ LogicalType PostgresUtils::TypeToLogicalType(optional_ptr<PostgresTransaction> t
 		child_type_info.type_modifier = type_info.type_modifier;
 		PostgresType child_pg_type;
 		auto child_type = PostgresUtils::TypeToLogicalType(transaction, schema, child_type_info, child_pg_type);
+		if (child_pg_type.oid == 0) {
+			// the element oid is written in binary arrays - custom types have their oid set already
+			child_pg_type.oid = PostgresNameToOid(child_type_info.type_name);
+		}
 		// construct the child type based on the number of dimensions
 		for (idx_t i = 1; i < dimensions; i++) {
 			PostgresType new_pg_type;
@@ -405,6 +409,45 @@ string PostgresUtils::PostgresOidToName(uint32_t oid) {
 	}
 }
 
+uint32_t PostgresUtils::PostgresNameToOid(const string &name) {
+	static const unordered_map<string, uint32_t> BUILTIN_OIDS {
+	    {"bool", BOOLOID},
+	    {"int2", INT2OID},
+	    {"int4", INT4OID},
+	    {"int8", INT8OID},
+	    {"oid", OIDOID},
+	    {"float4", FLOAT4OID},
+	    {"float8", FLOAT8OID},
+	    {"numeric", NUMERICOID},
+	    {"char", CHAROID},
+	    {"bpchar", BPCHAROID},
+	    {"varchar", VARCHAROID},
+	    {"text", TEXTOID},
+	    {"json", JSONOID},
+	    {"jsonb", JSONBOID},
+	    {"date", DATEOID},
+	    {"bytea", BYTEAOID},
+	    {"time", TIMEOID},
+	    {"timetz", TIMETZOID},
+	    {"timestamp", TIMESTAMPOID},
+	    {"timestamptz", TIMESTAMPTZOID},
+	    {"interval", INTERVALOID},
+	    {"uuid", UUIDOID},
+	    {"bit", BITOID},
+	    {"point", POINTOID},
+	    {"line", LINEOID},
+	    {"lseg", LSEGOID},
+	    {"box", BOXOID},
+	    {"path", PATHOID},
+	    {"polygon", POLYGONOID},
+	    {"circle", CIRCLEOID}};
+	auto entry = BUILTIN_OIDS.find(name);
+	if (entry == BUILTIN_OIDS.end()) {
+		return 0;
+	}
+	return entry->second;
+}
+
 uint32_t PostgresUtils::ToPostgresOid(const LogicalType &input) {
 	switch (input.id()) {
 	case LogicalTypeId::BOOLEAN:
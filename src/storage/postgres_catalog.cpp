@@ -181,4 +181,14 @@ void PostgresCatalog::ClearCache() {
 	schemas.ClearEntries();
 }
 
+bool PostgresCatalog::SupportsPreparedTransactions(PostgresTransaction &transaction) {
+	lock_guard<mutex> guard(prepared_transactions_lock);
+	if (!prepared_transactions_checked) {
+		auto result = transaction.Query("SELECT current_setting('max_prepared_transactions')::INT > 0");
+		supports_prepared_transactions = result->GetBool(0, 0);
+		prepared_transactions_checked = true;
+	}
+	return supports_prepared_transactions;
+}
+
 } // namespace duckdb
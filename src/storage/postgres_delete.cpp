@@ -127,7 +127,7 @@ PhysicalOperator &PostgresCatalog::PlanDelete(ClientContext &context, PhysicalPl
 		throw BinderException("RETURNING clause not yet supported for deletion of a Postgres table");
 	}
 	auto &bound_ref = op.expressions[0]->Cast<BoundReferenceExpression>();
-	PostgresCatalog::MaterializePostgresScans(plan);
+	PostgresCatalog::MaterializePostgresScans(context, plan);
 
 	auto &delete_op = planner.Make<PostgresDelete>(op, op.table, bound_ref.index);
 	delete_op.children.push_back(plan);
@@ -9,6 +9,8 @@
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/common/types/uuid.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "postgres_connection.hpp"
 #include "postgres_scanner.hpp"
 
@@ -29,19 +31,32 @@ PostgresInsert::PostgresInsert(PhysicalPlan &physical_plan, LogicalOperator &op,
 //===--------------------------------------------------------------------===//
 // States
 //===--------------------------------------------------------------------===//
+//! A COPY over a connection of its own - used when inserting in parallel
+struct PostgresInsertWriter {
+	PostgresPoolConnection connection;
+	PostgresCopyState copy_state;
+	DataChunk varchar_chunk;
+	bool copy_is_active = false;
+};
+
 class PostgresInsertGlobalState : public GlobalSinkState {
 public:
-	explicit PostgresInsertGlobalState(ClientContext &context, PostgresTableEntry &table, PostgresCopyFormat format)
-	    : table(table), insert_count(0), format(format) {
+	explicit PostgresInsertGlobalState(ClientContext &context, PostgresTableEntry &table, PostgresCopyFormat format,
+	                                   PostgresParallelInsertMode parallel_insert)
+	    : table(table), insert_count(0), format(format), parallel_insert(parallel_insert) {
 	}
 
 	PostgresTableEntry &table;
 	PostgresCopyState copy_state;
 	DataChunk varchar_chunk;
-	idx_t insert_count;
+	atomic<idx_t> insert_count;
 	PostgresCopyFormat format;
 	vector<string> insert_column_names;
 	bool copy_is_active = false;
+	PostgresParallelInsertMode parallel_insert;
+	//! The writer that is shared by the threads that could not obtain a connection of their own
+	mutex writer_lock;
+	unique_ptr<PostgresInsertWriter> shared_writer;
 
 	void FinishCopyTo(PostgresConnection &connection) {
 		if (!copy_is_active) {
@@ -52,6 +67,13 @@ public:
 	}
 };
 
+class PostgresInsertLocalState : public LocalSinkState {
+public:
+	//! The writer of this thread - empty if the thread writes using the shared writer
+	unique_ptr<PostgresInsertWriter> writer;
+	bool use_shared_writer = false;
+};
+
 vector<string> GetInsertColumns(const PostgresInsert &insert, PostgresTableEntry &entry) {
 	vector<string> column_names;
 	auto &columns = entry.GetColumns();
@@ -91,26 +113,105 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkState(ClientContext &co
 	auto &connection = transaction.GetConnection();
 	auto insert_columns = GetInsertColumns(*this, *insert_table);
 	auto format = insert_table->GetCopyFormat(context);
-	auto result = make_uniq<PostgresInsertGlobalState>(context, *insert_table, format);
+	auto result = make_uniq<PostgresInsertGlobalState>(context, *insert_table, format, parallel_insert);
 	auto &insert_column_names = result->insert_column_names;
+	// the Postgres types of the inserted columns are used to binary encode annotated and nested types
+	auto &insert_column_types = result->copy_state.postgres_types;
 	if (!insert_columns.empty()) {
+		bool all_columns_found = true;
 		for (auto &str : insert_columns) {
 			auto index = insert_table->GetColumnIndex(str, true);
 			if (!index.IsValid()) {
 				insert_column_names.push_back(str);
+				all_columns_found = false;
 			} else {
 				insert_column_names.push_back(insert_table->postgres_names[index.index]);
+				insert_column_types.push_back(insert_table->postgres_types[index.index]);
 			}
 		}
+		if (!all_columns_found) {
+			insert_column_types.clear();
+		}
+	} else {
+		insert_column_types = insert_table->postgres_types;
 	}
 	return std::move(result);
 }
 
+unique_ptr<LocalSinkState> PostgresInsert::GetLocalSinkState(ExecutionContext &context) const {
+	return make_uniq<PostgresInsertLocalState>();
+}
+
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
+static unique_ptr<PostgresInsertWriter> OpenInsertWriter(PostgresCatalog &catalog, bool force) {
+	auto &pool = catalog.GetConnectionPool();
+	auto result = make_uniq<PostgresInsertWriter>();
+	if (force) {
+		result->connection = pool.ForceGetConnection();
+	} else if (!pool.TryGetConnection(result->connection)) {
+		return nullptr;
+	}
+	result->connection.GetConnection().Execute("BEGIN");
+	return result;
+}
+
+static void WriteChunk(ClientContext &context, PostgresInsertGlobalState &gstate, PostgresInsertWriter &writer,
+                       DataChunk &chunk) {
+	auto &connection = writer.connection.GetConnection();
+	if (!writer.copy_is_active) {
+		writer.copy_state.postgres_types = gstate.copy_state.postgres_types;
+		connection.BeginCopyTo(context, writer.copy_state, gstate.format, gstate.table.schema.name, gstate.table.name,
+		                       gstate.insert_column_names);
+		writer.copy_is_active = true;
+	}
+	connection.CopyChunk(context, writer.copy_state, chunk, writer.varchar_chunk);
+}
+
+static void FinishInsertWriter(ClientContext &context, PostgresInsertGlobalState &gstate,
+                               PostgresInsertWriter &writer) {
+	auto &connection = writer.connection.GetConnection();
+	if (writer.copy_is_active) {
+		connection.FinishCopyTo(writer.copy_state);
+		writer.copy_is_active = false;
+	}
+	if (gstate.parallel_insert == PostgresParallelInsertMode::BULK) {
+		connection.Execute("COMMIT");
+		return;
+	}
+	// the transaction of the writer is committed or rolled back together with the transaction of the catalog
+	auto gid = "duckdb_insert_" + UUID::ToString(UUID::GenerateRandomUUID());
+	connection.Execute("PREPARE TRANSACTION " + KeywordHelper::WriteQuoted(gid, '\''));
+	PostgresTransaction::Get(context, gstate.table.catalog).AddPreparedTransaction(gid);
+}
+
+static void ParallelSink(ClientContext &context, PostgresInsertGlobalState &gstate, PostgresInsertLocalState &lstate,
+                         DataChunk &chunk) {
+	auto &catalog = gstate.table.catalog.Cast<PostgresCatalog>();
+	if (!lstate.writer && !lstate.use_shared_writer) {
+		lstate.writer = OpenInsertWriter(catalog, false);
+		// if the connection pool is exhausted we write using the shared writer
+		lstate.use_shared_writer = !lstate.writer;
+	}
+	if (lstate.writer) {
+		WriteChunk(context, gstate, *lstate.writer, chunk);
+		return;
+	}
+	lock_guard<mutex> guard(gstate.writer_lock);
+	if (!gstate.shared_writer) {
+		gstate.shared_writer = OpenInsertWriter(catalog, true);
+	}
+	WriteChunk(context, gstate, *gstate.shared_writer, chunk);
+}
+
 SinkResultType PostgresInsert::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
 	auto &gstate = input.global_state.Cast<PostgresInsertGlobalState>();
+	if (parallel_insert != PostgresParallelInsertMode::DISABLED) {
+		ParallelSink(context.client, gstate, input.local_state.Cast<PostgresInsertLocalState>(), chunk);
+		gstate.insert_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
 	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
 	auto &connection = transaction.GetConnection();
 	if (!gstate.copy_is_active) {
@@ -128,15 +229,40 @@ SinkResultType PostgresInsert::Sink(ExecutionContext &context, DataChunk &chunk,
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
+//===--------------------------------------------------------------------===//
+// Combine
+//===--------------------------------------------------------------------===//
+SinkCombineResultType PostgresInsert::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresInsertGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresInsertLocalState>();
+	if (lstate.writer) {
+		FinishInsertWriter(context.client, gstate, *lstate.writer);
+		lstate.writer.reset();
+	}
+	return SinkCombineResultType::FINISHED;
+}
+
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
 SinkFinalizeType PostgresInsert::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                           OperatorSinkFinalizeInput &input) const {
 	auto &gstate = input.global_state.Cast<PostgresInsertGlobalState>();
+	if (gstate.shared_writer) {
+		FinishInsertWriter(context, gstate, *gstate.shared_writer);
+		gstate.shared_writer.reset();
+	}
 	auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
-	auto &connection = transaction.GetConnection();
-	gstate.FinishCopyTo(connection);
+	if (parallel_insert == PostgresParallelInsertMode::DISABLED) {
+		gstate.FinishCopyTo(transaction.GetConnection());
+	} else if (gstate.insert_count > 0) {
+		// the rows were written over other connections - the transaction can no longer read through a snapshot
+		transaction.MarkWritten();
+	}
+	// update the approx_num_rows - if the table was empty the estimate is now exact
+	if (gstate.table.approx_num_rows > 0 || gstate.table.approx_num_pages == 0) {
+		gstate.table.approx_num_rows += gstate.insert_count;
+	}
 	// update the approx_num_pages - approximately 8 bytes per column per row
 	idx_t bytes_per_page = 8192;
 	idx_t bytes_per_row = gstate.table.GetColumns().LogicalColumnCount() * 8;
@@ -152,7 +278,7 @@ SourceResultType PostgresInsert::GetData(ExecutionContext &context, DataChunk &c
                                          OperatorSourceInput &input) const {
 	auto &insert_gstate = sink_state->Cast<PostgresInsertGlobalState>();
 	chunk.SetCardinality(1);
-	chunk.SetValue(0, 0, Value::BIGINT(insert_gstate.insert_count));
+	chunk.SetValue(0, 0, Value::BIGINT(NumericCast<int64_t>(insert_gstate.insert_count.load())));
 
 	return SourceResultType::FINISHED;
 }
@@ -216,20 +342,39 @@ bool PostgresCatalog::IsPostgresScan(const string &name) {
 	return name == "postgres_scan" || name == "postgres_scan_pushdown" || name == "postgres_query";
 }
 
-void PostgresCatalog::MaterializePostgresScans(PhysicalOperator &op) {
+void PostgresCatalog::MaterializePostgresScans(ClientContext &context, PhysicalOperator &op) {
 	if (op.type == PhysicalOperatorType::TABLE_SCAN) {
 		auto &table_scan = op.Cast<PhysicalTableScan>();
 		if (PostgresCatalog::IsPostgresScan(table_scan.function.name)) {
 			auto &bind_data = table_scan.bind_data->Cast<PostgresBindData>();
-			bind_data.requires_materialization = true;
-			bind_data.max_threads = 1;
-			bind_data.can_use_main_thread = true;
 			bind_data.emit_ctid = true;
+			// the connection of the transaction is used for writing - if the transaction has not written yet the
+			// scan can stream through its snapshot on connections of its own, otherwise we materialize up-front
+			if (!bind_data.TryUseTransactionSnapshot(context)) {
+				bind_data.requires_materialization = true;
+				bind_data.max_threads = 1;
+				bind_data.can_use_main_thread = true;
+			}
 		}
 	}
 	for (auto &child : op.children) {
-		MaterializePostgresScans(child);
+		MaterializePostgresScans(context, child);
+	}
+}
+
+PostgresParallelInsertMode PostgresInsert::GetParallelInsertMode(const string &value) {
+	auto mode = StringUtil::Lower(value);
+	if (mode == "disabled") {
+		return PostgresParallelInsertMode::DISABLED;
+	}
+	if (mode == "atomic") {
+		return PostgresParallelInsertMode::ATOMIC;
+	}
+	if (mode == "bulk") {
+		return PostgresParallelInsertMode::BULK;
 	}
+	throw InvalidInputException("Unsupported value \"%s\" for pg_parallel_insert - expected disabled, atomic or bulk",
+	                            value);
 }
 
 PhysicalOperator &PostgresCatalog::PlanInsert(ClientContext &context, PhysicalPlanGenerator &planner, LogicalInsert &op,
@@ -242,10 +387,29 @@ PhysicalOperator &PostgresCatalog::PlanInsert(ClientContext &context, PhysicalPl
 	}
 
 	D_ASSERT(plan);
-	MaterializePostgresScans(*plan);
+	MaterializePostgresScans(context, *plan);
 	auto &inner_plan = AddCastToPostgresTypes(context, planner, *plan);
 
 	auto &insert = planner.Make<PostgresInsert>(op, op.table, op.column_index_map);
+	Value parallel_insert;
+	if (context.TryGetCurrentSetting("pg_parallel_insert", parallel_insert) && !parallel_insert.IsNull()) {
+		insert.parallel_insert = PostgresInsert::GetParallelInsertMode(StringValue::Get(parallel_insert));
+	}
+	if (insert.parallel_insert != PostgresParallelInsertMode::DISABLED) {
+		// writes of other connections cannot see (or wait on) the writes of the transaction - we only insert in
+		// parallel if the transaction has not written yet
+		// within an explicit transaction the locks held by the connections (until the transaction commits) could
+		// block later statements of the transaction - these insert over the connection of the transaction
+		auto &transaction = PostgresTransaction::Get(context, *this);
+		if (version.type_v == PostgresInstanceType::REDSHIFT || !context.transaction.IsAutoCommit() ||
+		    transaction.HasWritten()) {
+			insert.parallel_insert = PostgresParallelInsertMode::DISABLED;
+		} else if (insert.parallel_insert == PostgresParallelInsertMode::ATOMIC &&
+		           !SupportsPreparedTransactions(transaction)) {
+			// atomic inserts prepare the transactions of the connections
+			insert.parallel_insert = PostgresParallelInsertMode::DISABLED;
+		}
+	}
 	insert.children.push_back(inner_plan);
 	return insert;
 }
@@ -253,7 +417,7 @@ PhysicalOperator &PostgresCatalog::PlanInsert(ClientContext &context, PhysicalPl
 PhysicalOperator &PostgresCatalog::PlanCreateTableAs(ClientContext &context, PhysicalPlanGenerator &planner,
                                                      LogicalCreateTable &op, PhysicalOperator &plan) {
 	auto &inner_plan = AddCastToPostgresTypes(context, planner, plan);
-	MaterializePostgresScans(inner_plan);
+	MaterializePostgresScans(context, inner_plan);
 
 	auto &insert = planner.Make<PostgresInsert>(op, op.schema, std::move(op.info));
 	insert.children.push_back(inner_plan);
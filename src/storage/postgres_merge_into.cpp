@@ -85,6 +85,7 @@ unique_ptr<MergeIntoOperator> PostgresPlanMergeIntoAction(PostgresCatalog &catal
 		// MERGE cannot keep the copy alive because we can interleave with other operations
 		auto &pg_insert = result->op->Cast<PostgresInsert>();
 		pg_insert.keep_copy_alive = false;
+		pg_insert.parallel_insert = PostgresParallelInsertMode::DISABLED;
 		break;
 	}
 	case MergeActionType::MERGE_ERROR:
@@ -2,9 +2,25 @@
 #include "storage/postgres_schema_entry.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "storage/postgres_optimizer.hpp"
+#include "duckdb/catalog/catalog_entry/aggregate_function_catalog_entry.hpp"
+#include "duckdb/function/function_binder.hpp"
+#include "duckdb/optimizer/column_binding_replacer.hpp"
+#include "duckdb/optimizer/optimizer.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/operator/logical_distinct.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_top_n.hpp"
 #include "storage/postgres_catalog.hpp"
+#include "postgres_filter_pushdown.hpp"
 #include "postgres_scanner.hpp"
 
 namespace duckdb {
@@ -13,7 +29,195 @@ struct PostgresOperators {
 	reference_map_t<PostgresCatalog, vector<reference<LogicalGet>>> scans;
 };
 
+//! A column of the query that is generated when an aggregate is pushed into a Postgres scan
+struct PostgresPushdownColumn {
+	//! The SQL expression that computes the column in Postgres
+	string expression;
+	LogicalType type;
+	PostgresType postgres_type;
+	//! The aggregate that combines the results of the individual tasks of a parallel scan
+	string combine_function;
+};
+
+static bool CanPushIntoScan(LogicalOperator &op) {
+	if (op.type != LogicalOperatorType::LOGICAL_GET) {
+		return false;
+	}
+	auto &get = op.Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return false;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.limit.empty() || !bind_data.column_expressions.empty()) {
+		// the limit has to be applied first - or an aggregate has already been pushed
+		return false;
+	}
+	for (auto &entry : get.table_filters.filters) {
+		if (entry.second->filter_type == TableFilterType::DYNAMIC_FILTER) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! Find the (table) column of a Postgres scan that a binding refers to, optionally through a projection
+static optional_idx GetScanColumn(ColumnBinding binding, optional_ptr<LogicalProjection> projection, LogicalGet &get) {
+	if (projection) {
+		if (binding.table_index != projection->table_index) {
+			return optional_idx();
+		}
+		auto &projected = *projection->expressions[binding.column_index];
+		if (projected.type != ExpressionType::BOUND_COLUMN_REF) {
+			return optional_idx();
+		}
+		binding = projected.Cast<BoundColumnRefExpression>().binding;
+	}
+	if (binding.table_index != get.table_index) {
+		return optional_idx();
+	}
+	auto column_index = binding.column_index;
+	if (!get.projection_ids.empty()) {
+		column_index = get.projection_ids[column_index];
+	}
+	auto &column_id = get.GetColumnIds()[column_index];
+	if (column_id.IsRowIdColumn() || column_id.HasChildren() || IsVirtualColumn(column_id.GetPrimaryIndex())) {
+		return optional_idx();
+	}
+	return column_id.GetPrimaryIndex();
+}
+
+static optional_idx GetScanColumn(Expression &expr, optional_ptr<LogicalProjection> projection, LogicalGet &get) {
+	if (expr.type != ExpressionType::BOUND_COLUMN_REF) {
+		return optional_idx();
+	}
+	return GetScanColumn(expr.Cast<BoundColumnRefExpression>().binding, projection, get);
+}
+
+//! Whether or not Postgres groups values of this type the same way as DuckDB
+static bool SupportsGroupPushdown(const LogicalType &type, const PostgresType &postgres_type) {
+	if (postgres_type.info != PostgresTypeAnnotation::STANDARD || type.HasAlias()) {
+		return false;
+	}
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::UUID:
+	case LogicalTypeId::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! Whether or not Postgres orders values of this type the same way as DuckDB
+static bool SupportsOrderPushdown(const LogicalType &type, const PostgresType &postgres_type) {
+	// strings are ordered with the "C" collation - the other types have the same order in both systems
+	return SupportsGroupPushdown(type, postgres_type);
+}
+
+//! Find the (table) column of a Postgres scan that a binding refers to through any number of projections
+static optional_idx GetTopNScanColumn(ColumnBinding binding, LogicalOperator &op, LogicalGet &get) {
+	reference<LogicalOperator> child = op;
+	while (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		auto &projection = child.get().Cast<LogicalProjection>();
+		if (binding.table_index != projection.table_index) {
+			return optional_idx();
+		}
+		auto &projected = *projection.expressions[binding.column_index];
+		if (projected.type != ExpressionType::BOUND_COLUMN_REF) {
+			return optional_idx();
+		}
+		binding = projected.Cast<BoundColumnRefExpression>().binding;
+		child = *child.get().children[0];
+	}
+	return GetScanColumn(binding, nullptr, get);
+}
+
+//! Push an ORDER BY ... LIMIT into a single Postgres query - which can use an index on the order columns
+static bool OptimizePostgresTopN(unique_ptr<LogicalOperator> &op) {
+	auto &top_n = op->Cast<LogicalTopN>();
+	reference<LogicalOperator> child = *op->children[0];
+	while (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		child = *child.get().children[0];
+	}
+	if (child.get().type != LogicalOperatorType::LOGICAL_GET) {
+		return false;
+	}
+	auto &get = child.get().Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return false;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.limit.empty() || !bind_data.column_expressions.empty() || !bind_data.can_use_main_thread) {
+		return false;
+	}
+	vector<string> orders;
+	for (auto &order : top_n.orders) {
+		if (order.expression->type != ExpressionType::BOUND_COLUMN_REF) {
+			return false;
+		}
+		auto &binding = order.expression->Cast<BoundColumnRefExpression>().binding;
+		auto column_id = GetTopNScanColumn(binding, *op->children[0], get);
+		if (!column_id.IsValid()) {
+			return false;
+		}
+		auto column_index = column_id.GetIndex();
+		auto &type = bind_data.types[column_index];
+		if (!SupportsOrderPushdown(type, bind_data.postgres_types[column_index])) {
+			return false;
+		}
+		string order_str = KeywordHelper::WriteQuoted(bind_data.names[column_index], '"');
+		if (type.id() == LogicalTypeId::VARCHAR) {
+			// DuckDB orders strings byte-wise
+			order_str += "::TEXT COLLATE \"C\"";
+		}
+		switch (order.type) {
+		case OrderType::ASCENDING:
+			order_str += " ASC";
+			break;
+		case OrderType::DESCENDING:
+			order_str += " DESC";
+			break;
+		default:
+			return false;
+		}
+		switch (order.null_order) {
+		case OrderByNullType::NULLS_FIRST:
+			order_str += " NULLS FIRST";
+			break;
+		case OrderByNullType::NULLS_LAST:
+			order_str += " NULLS LAST";
+			break;
+		default:
+			return false;
+		}
+		orders.push_back(std::move(order_str));
+	}
+	bind_data.order_by = " ORDER BY " + StringUtil::Join(orders, ", ");
+	bind_data.limit = " LIMIT " + to_string(top_n.limit);
+	if (top_n.offset > 0) {
+		bind_data.limit += " OFFSET " + to_string(top_n.offset);
+	}
+	// the rows are returned in order by a single query
+	bind_data.SetPartitions(vector<string>());
+	bind_data.SetTablePages(0);
+	op = std::move(op->children[0]);
+	return true;
+}
+
 static void OptimizePostgresScanLimitPushdown(unique_ptr<LogicalOperator> &op) {
+	if (op->type == LogicalOperatorType::LOGICAL_TOP_N && OptimizePostgresTopN(op)) {
+		return;
+	}
 	if (op->type == LogicalOperatorType::LOGICAL_LIMIT) {
 		auto &limit = op->Cast<LogicalLimit>();
 		reference<LogicalOperator> child = *op->children[0];
@@ -53,9 +257,20 @@ static void OptimizePostgresScanLimitPushdown(unique_ptr<LogicalOperator> &op) {
 		}
 
 		auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+		if (bind_data.HasPartitions() && bind_data.can_use_main_thread) {
+			// prefer pushing the limit into a single query over scanning partitions in parallel
+			bind_data.SetPartitions(vector<string>());
+		}
 		if (bind_data.max_threads != 1 || !bind_data.can_use_main_thread) {
-			// cannot push down limit/offset if we are not using the main thread
-			OptimizePostgresScanLimitPushdown(op->children[0]);
+			// we cannot push the limit into a single query - but no task needs to return more than limit + offset
+			// rows, and no new tasks need to be started once that many rows have been scanned
+			if (limit.limit_val.Type() == LimitNodeType::CONSTANT_VALUE && bind_data.limit.empty()) {
+				bind_data.max_rows = limit.limit_val.GetConstantValue();
+				if (limit.offset_val.Type() == LimitNodeType::CONSTANT_VALUE) {
+					bind_data.max_rows += limit.offset_val.GetConstantValue();
+				}
+				bind_data.limit = " LIMIT " + to_string(bind_data.max_rows);
+			}
 			return;
 		}
 
@@ -80,6 +295,613 @@ static void OptimizePostgresScanLimitPushdown(unique_ptr<LogicalOperator> &op) {
 	}
 }
 
+//! Whether or not MIN/MAX of this type can be computed in Postgres - strings are excluded as their order depends on
+//! the collation in Postgres
+static bool SupportsMinMaxPushdown(const LogicalType &type, const PostgresType &postgres_type) {
+	if (!SupportsGroupPushdown(type, postgres_type)) {
+		return false;
+	}
+	return type.IsNumeric() || type.id() == LogicalTypeId::DATE || type.id() == LogicalTypeId::TIME ||
+	       type.id() == LogicalTypeId::TIMESTAMP || type.id() == LogicalTypeId::TIMESTAMP_TZ;
+}
+
+static PostgresPushdownColumn GetGroupColumn(const PostgresBindData &bind_data, idx_t column_id) {
+	PostgresPushdownColumn result;
+	result.expression = KeywordHelper::WriteQuoted(bind_data.names[column_id], '"');
+	if (bind_data.types[column_id].id() == LogicalTypeId::VARCHAR) {
+		// json cannot be grouped on in Postgres - group on the text representation as DuckDB would
+		result.expression += "::TEXT";
+	}
+	result.type = bind_data.types[column_id];
+	result.postgres_type = bind_data.postgres_types[column_id];
+	return result;
+}
+
+static bool GetAggregateColumn(BoundAggregateExpression &aggr, optional_ptr<LogicalProjection> projection,
+                                LogicalGet &get, bool parallel, PostgresPushdownColumn &result) {
+	if (aggr.IsDistinct() || aggr.filter || (aggr.order_bys && !aggr.order_bys->orders.empty())) {
+		return false;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	auto &name = aggr.function.name;
+	if (name == "count_star" && aggr.children.empty()) {
+		result.expression = "count(*)";
+		result.type = LogicalType::BIGINT;
+		result.combine_function = "sum";
+		return true;
+	}
+	if (aggr.children.size() != 1) {
+		return false;
+	}
+	auto column_id = GetScanColumn(*aggr.children[0], projection, get);
+	if (!column_id.IsValid()) {
+		return false;
+	}
+	auto &type = bind_data.types[column_id.GetIndex()];
+	auto &postgres_type = bind_data.postgres_types[column_id.GetIndex()];
+	auto column_name = KeywordHelper::WriteQuoted(bind_data.names[column_id.GetIndex()], '"');
+	if (name == "count") {
+		result.expression = "count(" + column_name + ")";
+		result.type = LogicalType::BIGINT;
+		result.combine_function = "sum";
+		return true;
+	}
+	if (name == "min" || name == "max") {
+		if (!SupportsMinMaxPushdown(type, postgres_type)) {
+			return false;
+		}
+		result.expression = name + "(" + column_name + ")";
+		result.type = type;
+		result.postgres_type = postgres_type;
+		result.combine_function = name;
+		return true;
+	}
+	if (name != "sum" && name != "avg") {
+		return false;
+	}
+	if (postgres_type.info != PostgresTypeAnnotation::STANDARD) {
+		return false;
+	}
+	// floating point sums are not pushed down as their result depends on the order of summation
+	uint8_t scale;
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		scale = 0;
+		break;
+	case LogicalTypeId::DECIMAL:
+		scale = DecimalType::GetScale(type);
+		break;
+	default:
+		return false;
+	}
+	if (name == "avg") {
+		if (parallel) {
+			// the average cannot be combined from the averages of the individual tasks
+			return false;
+		}
+		result.expression = "avg(" + column_name + ")::FLOAT8";
+		result.type = LogicalType::DOUBLE;
+		return true;
+	}
+	result.expression = StringUtil::Format("sum(%s)::NUMERIC(38,%d)", column_name, scale);
+	result.type = LogicalType::DECIMAL(Decimal::MAX_WIDTH_DECIMAL, scale);
+	result.combine_function = "sum";
+	return true;
+}
+
+//! Transform the table filters of a Postgres scan - returns false if any of them cannot be evaluated by Postgres
+static bool TransformScanFilters(LogicalGet &get, string &result) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	vector<column_t> column_ids;
+	for (auto &column_id : get.GetColumnIds()) {
+		column_ids.push_back(column_id.GetPrimaryIndex());
+	}
+	return PostgresFilterPushdown::TryTransformFilters(column_ids, &get.table_filters, bind_data.names,
+	                                                   bind_data.postgres_types, result);
+}
+
+//! Replace the columns scanned by a Postgres scan with the given (aggregate) expressions - the filter is the
+//! transformed table filters of the scan
+static void PushdownScanColumns(LogicalGet &get, const string &filter, vector<PostgresPushdownColumn> columns,
+                                idx_t group_count) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	// the filters of the scan are applied to the rows of the table before grouping
+	bind_data.AddSourceFilter(filter);
+	get.table_filters.filters.clear();
+
+	vector<string> group_by;
+	for (idx_t i = 0; i < group_count; i++) {
+		group_by.push_back(to_string(i + 1));
+	}
+	bind_data.group_by = group_by.empty() ? string() : " GROUP BY " + StringUtil::Join(group_by, ", ");
+
+	bind_data.column_expressions.clear();
+	bind_data.names.clear();
+	bind_data.types.clear();
+	bind_data.postgres_types.clear();
+	bind_data.emit_ctid = false;
+	get.projection_ids.clear();
+	get.GetMutableColumnIds().clear();
+	get.returned_types.clear();
+	get.names.clear();
+	for (idx_t i = 0; i < columns.size(); i++) {
+		auto name = "__pg_column_" + to_string(i);
+		bind_data.column_expressions.push_back(std::move(columns[i].expression));
+		bind_data.names.push_back(name);
+		bind_data.types.push_back(columns[i].type);
+		bind_data.postgres_types.push_back(std::move(columns[i].postgres_type));
+		get.returned_types.push_back(columns[i].type);
+		get.names.push_back(std::move(name));
+		get.AddColumnId(i);
+	}
+}
+
+static unique_ptr<Expression> BindCombineAggregate(ClientContext &context, const string &name,
+                                                   unique_ptr<Expression> child) {
+	auto &entry = Catalog::GetEntry<AggregateFunctionCatalogEntry>(context, SYSTEM_CATALOG, DEFAULT_SCHEMA, name);
+	auto function = entry.functions.GetFunctionByArguments(context, {child->return_type});
+	vector<unique_ptr<Expression>> children;
+	children.push_back(std::move(child));
+	FunctionBinder function_binder(context);
+	return function_binder.BindAggregateFunction(function, std::move(children));
+}
+
+static bool OptimizePostgresAggregate(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &plan,
+                                      unique_ptr<LogicalOperator> &op) {
+	auto &aggr = op->Cast<LogicalAggregate>();
+	if (aggr.grouping_sets.size() > 1 || !aggr.grouping_functions.empty()) {
+		return false;
+	}
+	optional_ptr<LogicalProjection> projection;
+	reference<LogicalOperator> child = *op->children[0];
+	if (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		projection = child.get().Cast<LogicalProjection>();
+		child = *child.get().children[0];
+	}
+	if (!CanPushIntoScan(child.get())) {
+		return false;
+	}
+	auto &get = child.get().Cast<LogicalGet>();
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	// if the scan is split into multiple tasks every task computes a partial aggregate that we combine in DuckDB
+	bool parallel = bind_data.max_threads > 1;
+
+	vector<PostgresPushdownColumn> columns;
+	for (auto &group : aggr.groups) {
+		auto column_id = GetScanColumn(*group, projection, get);
+		if (!column_id.IsValid() || group->return_type != bind_data.types[column_id.GetIndex()] ||
+		    !SupportsGroupPushdown(group->return_type, bind_data.postgres_types[column_id.GetIndex()])) {
+			return false;
+		}
+		columns.push_back(GetGroupColumn(bind_data, column_id.GetIndex()));
+	}
+	for (auto &expr : aggr.expressions) {
+		if (expr->GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+			return false;
+		}
+		PostgresPushdownColumn column;
+		if (!GetAggregateColumn(expr->Cast<BoundAggregateExpression>(), projection, get, parallel, column)) {
+			return false;
+		}
+		columns.push_back(std::move(column));
+	}
+
+	// the rows are grouped in Postgres - all filters of the scan have to be applied there
+	string filter;
+	if (!TransformScanFilters(get, filter)) {
+		return false;
+	}
+
+	// all groups and aggregates can be computed in Postgres - rewrite the scan
+	auto group_count = aggr.groups.size();
+	if (!parallel) {
+		// run the aggregate as a single query
+		bind_data.SetPartitions(vector<string>());
+		bind_data.SetTablePages(0);
+	}
+	vector<string> combine_functions;
+	for (auto &column : columns) {
+		combine_functions.push_back(column.combine_function);
+	}
+	PushdownScanColumns(get, filter, std::move(columns), group_count);
+
+	// the results of the scan - if the scan is parallel these are partial aggregates that need to be combined
+	auto table_index = get.table_index;
+	vector<unique_ptr<Expression>> results;
+	for (idx_t i = 0; i < get.returned_types.size(); i++) {
+		results.push_back(make_uniq<BoundColumnRefExpression>(get.returned_types[i], ColumnBinding(table_index, i)));
+	}
+	unique_ptr<LogicalOperator> result_op = projection ? std::move(op->children[0]->children[0])
+	                                                   : std::move(op->children[0]);
+	if (parallel) {
+		auto group_index = binder.GenerateTableIndex();
+		auto aggregate_index = binder.GenerateTableIndex();
+		vector<unique_ptr<Expression>> aggregates;
+		for (idx_t i = group_count; i < results.size(); i++) {
+			aggregates.push_back(BindCombineAggregate(context, combine_functions[i], std::move(results[i])));
+		}
+		auto combine = make_uniq<LogicalAggregate>(group_index, aggregate_index, std::move(aggregates));
+		combine->groupings_index = binder.GenerateTableIndex();
+		GroupingSet grouping_set;
+		for (idx_t i = 0; i < group_count; i++) {
+			grouping_set.insert(i);
+			combine->groups.push_back(std::move(results[i]));
+		}
+		if (group_count > 0) {
+			combine->grouping_sets.push_back(std::move(grouping_set));
+		}
+		results.clear();
+		for (idx_t i = 0; i < group_count; i++) {
+			results.push_back(
+			    make_uniq<BoundColumnRefExpression>(combine->groups[i]->return_type, ColumnBinding(group_index, i)));
+		}
+		for (idx_t i = 0; i < combine->expressions.size(); i++) {
+			auto &type = combine->expressions[i]->return_type;
+			unique_ptr<Expression> result =
+			    make_uniq<BoundColumnRefExpression>(type, ColumnBinding(aggregate_index, i));
+			auto &original = aggr.expressions[i]->Cast<BoundAggregateExpression>();
+			if (group_count == 0 && StringUtil::StartsWith(original.function.name, "count")) {
+				// the count of an empty scan is 0
+				auto coalesce = make_uniq<BoundOperatorExpression>(ExpressionType::OPERATOR_COALESCE, type);
+				coalesce->children.push_back(std::move(result));
+				coalesce->children.push_back(make_uniq<BoundConstantExpression>(Value::Numeric(type, 0)));
+				result = std::move(coalesce);
+			}
+			results.push_back(std::move(result));
+		}
+		combine->children.push_back(std::move(result_op));
+		result_op = std::move(combine);
+	}
+
+	// cast the results to the types of the original aggregate and replace all references to the aggregate
+	auto projection_index = binder.GenerateTableIndex();
+	vector<unique_ptr<Expression>> select_list;
+	ColumnBindingReplacer replacer;
+	for (idx_t i = 0; i < results.size(); i++) {
+		bool is_group = i < group_count;
+		auto &type = is_group ? aggr.groups[i]->return_type : aggr.expressions[i - group_count]->return_type;
+		select_list.push_back(BoundCastExpression::AddCastToType(context, std::move(results[i]), type));
+		auto binding =
+		    is_group ? ColumnBinding(aggr.group_index, i) : ColumnBinding(aggr.aggregate_index, i - group_count);
+		replacer.replacement_bindings.emplace_back(binding, ColumnBinding(projection_index, i));
+	}
+	auto result = make_uniq<LogicalProjection>(projection_index, std::move(select_list));
+	if (aggr.has_estimated_cardinality) {
+		result->SetEstimatedCardinality(aggr.estimated_cardinality);
+	}
+	result->children.push_back(std::move(result_op));
+	op = std::move(result);
+	replacer.VisitOperator(*plan);
+	return true;
+}
+
+static bool OptimizePostgresDistinct(unique_ptr<LogicalOperator> &op) {
+	auto &distinct = op->Cast<LogicalDistinct>();
+	if (distinct.distinct_type != DistinctType::DISTINCT || distinct.order_by) {
+		return false;
+	}
+	optional_ptr<LogicalProjection> projection;
+	reference<LogicalOperator> child = *op->children[0];
+	if (child.get().type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		projection = child.get().Cast<LogicalProjection>();
+		child = *child.get().children[0];
+	}
+	if (!CanPushIntoScan(child.get())) {
+		return false;
+	}
+	auto &get = child.get().Cast<LogicalGet>();
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	auto &column_ids = get.GetColumnIds();
+	if (!get.projection_ids.empty()) {
+		// all scanned columns must be part of the result
+		for (idx_t i = 0; i < get.projection_ids.size(); i++) {
+			if (get.projection_ids[i] != i) {
+				return false;
+			}
+		}
+		if (get.projection_ids.size() != column_ids.size()) {
+			return false;
+		}
+	}
+	// group on all columns of the scan
+	vector<PostgresPushdownColumn> columns;
+	for (auto &column_id : column_ids) {
+		if (column_id.IsRowIdColumn() || column_id.HasChildren() || IsVirtualColumn(column_id.GetPrimaryIndex())) {
+			return false;
+		}
+		auto column_index = column_id.GetPrimaryIndex();
+		if (!SupportsGroupPushdown(bind_data.types[column_index], bind_data.postgres_types[column_index])) {
+			return false;
+		}
+		columns.push_back(GetGroupColumn(bind_data, column_index));
+	}
+	string filter;
+	if (!TransformScanFilters(get, filter)) {
+		return false;
+	}
+	// the distinct is only fully computed by Postgres if the result consists of exactly the scanned columns
+	bool remove_distinct = bind_data.max_threads <= 1;
+	if (projection) {
+		unordered_set<idx_t> projected_columns;
+		for (auto &expr : projection->expressions) {
+			if (expr->type != ExpressionType::BOUND_COLUMN_REF) {
+				remove_distinct = false;
+				break;
+			}
+			projected_columns.insert(expr->Cast<BoundColumnRefExpression>().binding.column_index);
+		}
+		if (projected_columns.size() != columns.size()) {
+			remove_distinct = false;
+		}
+	}
+	if (remove_distinct) {
+		// run the distinct as a single query
+		bind_data.SetPartitions(vector<string>());
+		bind_data.SetTablePages(0);
+	}
+	// otherwise every task removes duplicates from its part of the table and the distinct is completed in DuckDB
+	auto group_count = columns.size();
+	PushdownScanColumns(get, filter, std::move(columns), group_count);
+	if (remove_distinct) {
+		op = std::move(op->children[0]);
+	}
+	return true;
+}
+
+static void OptimizePostgresScanAggregatePushdown(ClientContext &context, Binder &binder,
+                                                  unique_ptr<LogicalOperator> &plan, unique_ptr<LogicalOperator> &op) {
+	switch (op->type) {
+	case LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY:
+		if (OptimizePostgresAggregate(context, binder, plan, op)) {
+			return;
+		}
+		break;
+	case LogicalOperatorType::LOGICAL_DISTINCT:
+		if (OptimizePostgresDistinct(op)) {
+			return;
+		}
+		break;
+	default:
+		break;
+	}
+	for (auto &child : op->children) {
+		OptimizePostgresScanAggregatePushdown(context, binder, plan, child);
+	}
+}
+
+//! One side of a join that is pushed into Postgres
+struct PostgresJoinInput {
+	optional_ptr<LogicalProjection> projection;
+	optional_ptr<LogicalGet> get;
+	//! The SQL that produces the (filtered) rows of the input
+	string source;
+	//! The output bindings of the input, and the scanned columns they refer to
+	vector<ColumnBinding> bindings;
+	vector<idx_t> column_ids;
+
+public:
+	const PostgresBindData &GetBindData() const {
+		return get->bind_data->Cast<PostgresBindData>();
+	}
+	string GetColumn(const string &alias, idx_t column_id) const {
+		auto &bind_data = GetBindData();
+		return alias + "." + KeywordHelper::WriteQuoted(bind_data.names[column_id], '"');
+	}
+};
+
+static bool GetJoinInput(LogicalOperator &op, PostgresJoinInput &result) {
+	reference<LogicalOperator> child = op;
+	if (op.type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		result.projection = op.Cast<LogicalProjection>();
+		child = *op.children[0];
+	}
+	if (!CanPushIntoScan(child.get())) {
+		return false;
+	}
+	result.get = child.get().Cast<LogicalGet>();
+	auto &get = *result.get;
+	auto &bind_data = result.GetBindData();
+	if (!bind_data.GetCatalog() || !bind_data.use_transaction ||
+	    bind_data.version.type_v == PostgresInstanceType::REDSHIFT) {
+		return false;
+	}
+	result.bindings = op.GetColumnBindings();
+	for (auto &binding : result.bindings) {
+		auto column_id = GetScanColumn(binding, result.projection, get);
+		if (!column_id.IsValid()) {
+			return false;
+		}
+		result.column_ids.push_back(column_id.GetIndex());
+	}
+	// the filters of the input are applied in Postgres - all of them have to be translated
+	string filter;
+	if (!TransformScanFilters(get, filter)) {
+		return false;
+	}
+	if (!bind_data.source_filter.empty()) {
+		filter = filter.empty() ? bind_data.source_filter : bind_data.source_filter + " AND " + filter;
+	}
+	string table;
+	if (bind_data.table_name.empty()) {
+		table = "(" + bind_data.sql + ") AS __unnamed_subquery";
+	} else {
+		table = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+		        KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+	}
+	if (filter.empty() && !bind_data.table_name.empty()) {
+		result.source = table;
+	} else {
+		result.source = "(SELECT * FROM " + table + (filter.empty() ? "" : " WHERE " + filter) + ")";
+	}
+	return true;
+}
+
+static bool GetJoinCondition(JoinCondition &condition, PostgresJoinInput &left, PostgresJoinInput &right,
+                             string &result) {
+	string comparison;
+	switch (condition.comparison) {
+	case ExpressionType::COMPARE_EQUAL:
+		comparison = " = ";
+		break;
+	case ExpressionType::COMPARE_NOT_DISTINCT_FROM:
+		comparison = " IS NOT DISTINCT FROM ";
+		break;
+	default:
+		return false;
+	}
+	auto left_column = GetScanColumn(*condition.left, left.projection, *left.get);
+	auto right_column = GetScanColumn(*condition.right, right.projection, *right.get);
+	if (!left_column.IsValid() || !right_column.IsValid()) {
+		return false;
+	}
+	auto &left_data = left.GetBindData();
+	auto &right_data = right.GetBindData();
+	auto &type = left_data.types[left_column.GetIndex()];
+	if (type != right_data.types[right_column.GetIndex()] ||
+	    !SupportsGroupPushdown(type, left_data.postgres_types[left_column.GetIndex()]) ||
+	    !SupportsGroupPushdown(type, right_data.postgres_types[right_column.GetIndex()])) {
+		return false;
+	}
+	// compare strings on their text representation as DuckDB would
+	string cast = type.id() == LogicalTypeId::VARCHAR ? "::TEXT" : "";
+	result = left.GetColumn("t0", left_column.GetIndex()) + cast + comparison +
+	         right.GetColumn("t1", right_column.GetIndex()) + cast;
+	return true;
+}
+
+static bool FindJoinColumn(const PostgresJoinInput &input, const ColumnBinding &binding, idx_t &column_id) {
+	for (idx_t i = 0; i < input.bindings.size(); i++) {
+		if (input.bindings[i] == binding) {
+			column_id = input.column_ids[i];
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool OptimizePostgresJoin(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &plan,
+                                 unique_ptr<LogicalOperator> &op) {
+	auto &join = op->Cast<LogicalComparisonJoin>();
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::LEFT && join.join_type != JoinType::SEMI) {
+		return false;
+	}
+	PostgresJoinInput left;
+	PostgresJoinInput right;
+	if (!GetJoinInput(*op->children[0], left) || !GetJoinInput(*op->children[1], right)) {
+		return false;
+	}
+	auto &left_data = left.GetBindData();
+	auto &right_data = right.GetBindData();
+	if (left_data.GetCatalog().get() != right_data.GetCatalog().get()) {
+		// the inputs are not in the same database
+		return false;
+	}
+	vector<string> conditions;
+	for (auto &condition : join.conditions) {
+		string condition_sql;
+		if (!GetJoinCondition(condition, left, right, condition_sql)) {
+			return false;
+		}
+		conditions.push_back(std::move(condition_sql));
+	}
+	if (conditions.empty()) {
+		return false;
+	}
+
+	// generate the query that computes the join in Postgres - this produces the columns of the join (which respect
+	// its projection maps) in the same order
+	auto join_bindings = join.GetColumnBindings();
+	if (join_bindings.empty()) {
+		return false;
+	}
+	vector<string> select_list;
+	vector<string> names;
+	vector<LogicalType> types;
+	vector<PostgresType> postgres_types;
+	auto add_column = [&](const PostgresJoinInput &input, const string &alias, idx_t column_id) {
+		auto &bind_data = input.GetBindData();
+		auto name = "__pg_column_" + to_string(names.size());
+		select_list.push_back(input.GetColumn(alias, column_id) + " AS " + KeywordHelper::WriteQuoted(name, '"'));
+		names.push_back(std::move(name));
+		types.push_back(bind_data.types[column_id]);
+		postgres_types.push_back(bind_data.postgres_types[column_id]);
+	};
+	for (auto &binding : join_bindings) {
+		idx_t column_id;
+		if (FindJoinColumn(left, binding, column_id)) {
+			add_column(left, "t0", column_id);
+		} else if (FindJoinColumn(right, binding, column_id)) {
+			add_column(right, "t1", column_id);
+		} else {
+			return false;
+		}
+	}
+	auto join_condition = StringUtil::Join(conditions, " AND ");
+	string sql;
+	if (join.join_type == JoinType::SEMI) {
+		sql = StringUtil::Format("SELECT %s FROM %s AS t0 WHERE EXISTS (SELECT 1 FROM %s AS t1 WHERE %s)",
+		                         StringUtil::Join(select_list, ", "), left.source, right.source, join_condition);
+	} else {
+		sql = StringUtil::Format("SELECT %s FROM %s AS t0 %s %s AS t1 ON %s", StringUtil::Join(select_list, ", "),
+		                         left.source, join.join_type == JoinType::LEFT ? "LEFT JOIN" : "JOIN", right.source,
+		                         join_condition);
+	}
+
+	// only push joins that do not increase the amount of rows that need to be transferred - this uses the estimates
+	// of DuckDB's optimizer (based on the statistics of the tables) rather than querying Postgres while planning
+	auto &catalog = *left_data.GetCatalog();
+	auto join_rows = op->EstimateCardinality(context);
+	if (join.join_type != JoinType::SEMI) {
+		auto left_rows = op->children[0]->EstimateCardinality(context);
+		auto right_rows = op->children[1]->EstimateCardinality(context);
+		if (join_rows > left_rows + right_rows) {
+			return false;
+		}
+	}
+
+	auto bind_data = make_uniq<PostgresBindData>(context);
+	bind_data->version = left_data.version;
+	bind_data->dsn = left_data.dsn;
+	bind_data->attach_path = left_data.attach_path;
+	bind_data->SetCatalog(catalog);
+	bind_data->sql = std::move(sql);
+	bind_data->names = names;
+	bind_data->types = types;
+	bind_data->postgres_types = std::move(postgres_types);
+	bind_data->read_only = left_data.read_only && right_data.read_only;
+	bind_data->use_text_protocol = left_data.use_text_protocol || right_data.use_text_protocol;
+	bind_data->rows_approx = join_rows;
+	bind_data->SetTablePages(0);
+
+	auto table_index = binder.GenerateTableIndex();
+	auto get = make_uniq<LogicalGet>(table_index, left.get->function, std::move(bind_data), std::move(types),
+	                                 std::move(names));
+	ColumnBindingReplacer replacer;
+	for (idx_t i = 0; i < get->returned_types.size(); i++) {
+		get->AddColumnId(i);
+		replacer.replacement_bindings.emplace_back(join_bindings[i], ColumnBinding(table_index, i));
+	}
+	if (join.has_estimated_cardinality) {
+		get->SetEstimatedCardinality(join.estimated_cardinality);
+	}
+	op = std::move(get);
+	replacer.VisitOperator(*plan);
+	return true;
+}
+
+static void OptimizePostgresScanJoinPushdown(ClientContext &context, Binder &binder, unique_ptr<LogicalOperator> &plan,
+                                             unique_ptr<LogicalOperator> &op) {
+	// push joins bottom-up so that joins over (pushed) joins can be pushed as well
+	for (auto &child : op->children) {
+		OptimizePostgresScanJoinPushdown(context, binder, plan, child);
+	}
+	if (op->type == LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		OptimizePostgresJoin(context, binder, plan, op);
+	}
+}
+
 void GatherPostgresScans(LogicalOperator &op, PostgresOperators &result) {
 	if (op.type == LogicalOperatorType::LOGICAL_GET) {
 		auto &get = op.Cast<LogicalGet>();
@@ -103,6 +925,18 @@ void GatherPostgresScans(LogicalOperator &op, PostgresOperators &result) {
 }
 
 void PostgresOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+	// look at the query plan and check if we can push joins into Postgres
+	Value join_pushdown;
+	if (input.context.TryGetCurrentSetting("pg_experimental_join_pushdown", join_pushdown) &&
+	    BooleanValue::Get(join_pushdown)) {
+		OptimizePostgresScanJoinPushdown(input.context, input.optimizer.binder, plan, plan);
+	}
+	// look at the query plan and check if we can push aggregates into Postgres
+	Value aggregate_pushdown;
+	if (input.context.TryGetCurrentSetting("pg_experimental_aggregate_pushdown", aggregate_pushdown) &&
+	    BooleanValue::Get(aggregate_pushdown)) {
+		OptimizePostgresScanAggregatePushdown(input.context, input.optimizer.binder, plan, plan);
+	}
 	// look at query plan and check if we can find LIMIT/OFFSET to pushdown
 	OptimizePostgresScanLimitPushdown(plan);
 	// look at the query plan and check if we can enable streaming query scans
@@ -117,6 +951,12 @@ void PostgresOptimizer::Optimize(OptimizerExtensionInput &input, unique_ptr<Logi
 		auto multiple_scans = entry.second.size() > 1;
 		for (auto &scan : entry.second) {
 			auto &bind_data = scan.get().bind_data->Cast<PostgresBindData>();
+			if (!bind_data.read_only && (multiple_scans || bind_data.HasTasks()) &&
+			    bind_data.TryUseTransactionSnapshot(input.context)) {
+				// the transaction has not written yet - read-write scans can stream in parallel on connections of
+				// their own through the snapshot of the transaction
+				continue;
+			}
 			// if there is a single scan in the plan we can always stream using the main thread
 			// if there is more than one scan we either (1) need to materialize, or (2) cannot use the main thread
 			if (multiple_scans) {
@@ -5,6 +5,8 @@
 #include "duckdb/storage/table_storage_info.hpp"
 #include "duckdb/parser/constraints/unique_constraint.hpp"
 #include "postgres_scanner.hpp"
+#include "postgres_partitioning.hpp"
+#include "postgres_type_oids.hpp"
 
 namespace duckdb {
 
@@ -19,6 +21,7 @@ PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &sch
 		postgres_names.push_back(col.GetName());
 	}
 	approx_num_pages = 0;
+	approx_num_rows = 0;
 }
 
 PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, PostgresTableInfo &info)
@@ -26,16 +29,204 @@ PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &sch
       postgres_names(std::move(info.postgres_names)) {
 	D_ASSERT(postgres_types.size() == columns.LogicalColumnCount());
 	approx_num_pages = info.approx_num_pages;
+	approx_num_rows = info.approx_num_rows;
+}
+
+void PostgresTableEntry::LoadStatistics(PostgresTransaction &transaction) {
+	distinct_counts.resize(postgres_names.size(), 0);
+	if (catalog.Cast<PostgresCatalog>().GetPostgresVersion().type_v == PostgresInstanceType::REDSHIFT) {
+		return;
+	}
+	// negative values of n_distinct are a fraction of the number of rows in the table
+	// for partitioned or inherited tables we prefer the statistics over the entire hierarchy
+	auto query = StringUtil::Format(
+	    "SELECT s.attname, s.n_distinct, c.reltuples FROM pg_stats s JOIN pg_namespace n ON n.nspname=s.schemaname "
+	    "JOIN pg_class c ON c.relnamespace=n.oid AND c.relname=s.tablename "
+	    "WHERE s.schemaname=%s AND s.tablename=%s AND s.n_distinct IS NOT NULL ORDER BY s.inherited DESC",
+	    KeywordHelper::WriteQuoted(schema.name), KeywordHelper::WriteQuoted(name));
+	auto result = transaction.Query(query);
+	for (idx_t row = 0; row < result->Count(); row++) {
+		auto column_name = result->GetString(row, 0);
+		auto n_distinct = result->GetDouble(row, 1);
+		auto reltuples = result->IsNull(row, 2) ? 0 : result->GetDouble(row, 2);
+		if (n_distinct < 0) {
+			n_distinct = reltuples > 0 ? -n_distinct * reltuples : 0;
+		}
+		if (n_distinct < 1) {
+			continue;
+		}
+		for (idx_t col_idx = 0; col_idx < postgres_names.size(); col_idx++) {
+			if (postgres_names[col_idx] == column_name && distinct_counts[col_idx] == 0) {
+				distinct_counts[col_idx] = idx_t(n_distinct);
+				break;
+			}
+		}
+	}
 }
 
 unique_ptr<BaseStatistics> PostgresTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
-	return nullptr;
+	if (column_id >= postgres_names.size()) {
+		// row id
+		return nullptr;
+	}
+	idx_t distinct_count;
+	{
+		lock_guard<mutex> guard(statistics_lock);
+		if (!statistics_loaded) {
+			auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
+			LoadStatistics(transaction);
+			statistics_loaded = true;
+		}
+		distinct_count = distinct_counts[column_id];
+	}
+	if (distinct_count == 0) {
+		return nullptr;
+	}
+	// pg_stats is only updated by ANALYZE - we only expose the distinct count as an estimate, since the optimizer
+	// relies on min/max and NULL information being exact for e.g. pruning filters
+	auto &type = columns.GetColumn(LogicalIndex(column_id)).GetType();
+	auto stats = BaseStatistics::CreateUnknown(type);
+	stats.SetDistinctCount(distinct_count);
+	return stats.ToUnique();
 }
 
 void PostgresTableEntry::BindUpdateConstraints(Binder &binder, LogicalGet &, LogicalProjection &, LogicalUpdate &,
                                                ClientContext &) {
 }
 
+static bool SupportsKeyRanges(const LogicalType &type, const PostgresType &postgres_type) {
+	if (postgres_type.info != PostgresTypeAnnotation::STANDARD) {
+		return false;
+	}
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::UUID:
+	case LogicalTypeId::VARCHAR:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static string KeyRangeTypeName(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+		return "SMALLINT";
+	case LogicalTypeId::INTEGER:
+		return "INTEGER";
+	case LogicalTypeId::BIGINT:
+		return "BIGINT";
+	case LogicalTypeId::DATE:
+		return "DATE";
+	case LogicalTypeId::TIMESTAMP:
+		return "TIMESTAMP";
+	case LogicalTypeId::TIMESTAMP_TZ:
+		return "TIMESTAMPTZ";
+	case LogicalTypeId::UUID:
+		return "UUID";
+	case LogicalTypeId::VARCHAR:
+		return "TEXT";
+	default:
+		throw InternalException("Unsupported type for key ranges");
+	}
+}
+
+bool PostgresTableEntry::GetKeyRanges(PostgresTransaction &transaction, string &key_column,
+                                      vector<string> &boundaries) {
+	lock_guard<mutex> guard(key_range_lock);
+	if (!key_ranges_loaded) {
+		key_ranges_loaded = true;
+		// find a single-column key - preferring the primary key
+		optional_ptr<const ColumnDefinition> key;
+		for (auto &constraint : constraints) {
+			if (constraint->type != ConstraintType::UNIQUE) {
+				continue;
+			}
+			auto &unique = constraint->Cast<UniqueConstraint>();
+			if (unique.HasIndex() || unique.GetColumnNames().size() != 1) {
+				continue;
+			}
+			auto &column = columns.GetColumn(unique.GetColumnNames()[0]);
+			auto column_index = column.Logical().index;
+			if (!SupportsKeyRanges(column.GetType(), postgres_types[column_index])) {
+				continue;
+			}
+			if (!key || unique.IsPrimaryKey()) {
+				key = &column;
+			}
+		}
+		if (key) {
+			// the histogram bounds split the (non-NULL) values into buckets of equal size
+			// for partitioned or inherited tables we prefer the statistics over the entire hierarchy
+			auto &column_name = postgres_names[key->Logical().index];
+			auto query = StringUtil::Format(
+			    "SELECT b.bound::TEXT, b.bound > lag(b.bound) OVER (ORDER BY b.idx) FROM (SELECT histogram_bounds "
+			    "FROM pg_stats WHERE schemaname=%s AND tablename=%s AND attname=%s ORDER BY inherited DESC LIMIT 1) s, "
+			    "unnest(s.histogram_bounds::text::%s[]) WITH ORDINALITY AS b(bound, idx) ORDER BY b.idx",
+			    KeywordHelper::WriteQuoted(schema.name), KeywordHelper::WriteQuoted(name),
+			    KeywordHelper::WriteQuoted(column_name), KeyRangeTypeName(key->GetType()));
+			auto result = transaction.Query(query);
+			for (idx_t row = 0; row < result->Count(); row++) {
+				if (result->IsNull(row, 0)) {
+					continue;
+				}
+				if (!result->IsNull(row, 1) && !result->GetBool(row, 1)) {
+					// the bounds are not strictly increasing - we cannot split on them without overlapping ranges
+					key_range_boundaries.clear();
+					break;
+				}
+				key_range_boundaries.push_back(KeywordHelper::WriteQuoted(result->GetString(row, 0)));
+			}
+			key_range_column = column_name;
+		}
+	}
+	if (key_range_boundaries.size() < 3) {
+		return false;
+	}
+	key_column = key_range_column;
+	boundaries = key_range_boundaries;
+	return true;
+}
+
+void PostgresTableEntry::PrepareKeyRangeScan(ClientContext &context, PostgresTransaction &transaction,
+                                             PostgresBindData &bind_data) {
+	Value use_key_range_scan;
+	if (context.TryGetCurrentSetting("pg_use_key_range_scan", use_key_range_scan) &&
+	    !BooleanValue::Get(use_key_range_scan)) {
+		return;
+	}
+	if (bind_data.version.type_v == PostgresInstanceType::REDSHIFT) {
+		return;
+	}
+	auto partition_count = approx_num_pages / bind_data.pages_per_task;
+	if (partition_count <= 1) {
+		// small table - not worth splitting
+		return;
+	}
+	string key_column;
+	vector<string> histogram;
+	if (!GetKeyRanges(transaction, key_column, histogram)) {
+		return;
+	}
+	// the first and last entries of the histogram are the min and max - we can split on the inner entries
+	auto bucket_count = histogram.size() - 1;
+	partition_count = MinValue<idx_t>(partition_count, bucket_count);
+	vector<string> boundaries;
+	for (idx_t i = 1; i < partition_count; i++) {
+		auto &boundary = histogram[i * bucket_count / partition_count];
+		if (!boundaries.empty() && boundaries.back() == boundary) {
+			continue;
+		}
+		boundaries.push_back(boundary);
+	}
+	bind_data.SetPartitions(PostgresPartitioning::RangePartitions(key_column, boundaries));
+}
+
 TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) {
 	auto &pg_catalog = catalog.Cast<PostgresCatalog>();
 	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
@@ -54,7 +245,12 @@ TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique
 	result->names = postgres_names;
 	result->postgres_types = postgres_types;
 	result->read_only = transaction.IsReadOnly();
+	result->rows_approx = approx_num_rows;
 	PostgresScanFunction::PrepareBind(pg_catalog.GetPostgresVersion(), context, *result, approx_num_pages);
+	if (!result->HasTasks() && result->read_only) {
+		// we cannot use ctid ranges - try to split the scan on key ranges instead
+		PrepareKeyRangeScan(context, transaction, *result);
+	}
 
 	bind_data = std::move(result);
 	auto function = PostgresScanFunction();
@@ -92,32 +288,84 @@ TableStorageInfo PostgresTableEntry::GetStorageInfo(ClientContext &context) {
 	return result;
 }
 
+//! Whether or not values of the type can be written by the binary writer
+static bool SupportsBinaryCopy(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIME_TZ:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::INTERVAL:
+	case LogicalTypeId::UUID:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::ENUM:
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::STRUCT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+//! Whether or not the oid of an array element or the attribute of a composite type can be written in the binary format
+static bool SupportsBinaryElement(const LogicalType &type, const PostgresType &pg_type) {
+	if (type.id() == LogicalTypeId::LIST && pg_type.info == PostgresTypeAnnotation::STANDARD) {
+		// the dimension of a multidimensional array - the oid is taken from the innermost element type
+		return true;
+	}
+	if (pg_type.oid != 0) {
+		return true;
+	}
+	// the oid is unknown for tables created through DuckDB - their types are derived from the DuckDB types
+	return PostgresUtils::SupportedPostgresOid(type);
+}
+
 static bool CopyRequiresText(const LogicalType &type, const PostgresType &pg_type) {
-	if (pg_type.info != PostgresTypeAnnotation::STANDARD) {
+	switch (pg_type.info) {
+	case PostgresTypeAnnotation::STANDARD:
+		break;
+	case PostgresTypeAnnotation::FIXED_LENGTH_CHAR:
+		// the binary format of "char" is a single byte - only bpchar accepts the string as-is
+		return pg_type.oid != BPCHAROID;
+	case PostgresTypeAnnotation::JSONB:
+	case PostgresTypeAnnotation::GEOM_POINT:
+	case PostgresTypeAnnotation::GEOM_LINE:
+	case PostgresTypeAnnotation::GEOM_LINE_SEGMENT:
+	case PostgresTypeAnnotation::GEOM_BOX:
+	case PostgresTypeAnnotation::GEOM_PATH:
+	case PostgresTypeAnnotation::GEOM_POLYGON:
+	case PostgresTypeAnnotation::GEOM_CIRCLE:
+		// written in the binary format of the Postgres type
+		return false;
+	default:
+		return true;
+	}
+	if (!SupportsBinaryCopy(type)) {
 		return true;
 	}
 	switch (type.id()) {
 	case LogicalTypeId::LIST: {
 		D_ASSERT(pg_type.children.size() == 1);
 		auto &child_type = ListType::GetChildType(type);
-		if (child_type.id() != LogicalTypeId::LIST) {
-			if (!PostgresUtils::SupportedPostgresOid(child_type)) {
-				return true;
-			}
-			if (pg_type.children[0].oid != PostgresUtils::ToPostgresOid(child_type)) {
-				return true;
-			}
-		}
-		if (CopyRequiresText(child_type, pg_type.children[0])) {
+		if (!SupportsBinaryElement(child_type, pg_type.children[0])) {
 			return true;
 		}
-		return false;
+		return CopyRequiresText(child_type, pg_type.children[0]);
 	}
 	case LogicalTypeId::STRUCT: {
 		auto &children = StructType::GetChildTypes(type);
 		D_ASSERT(children.size() == pg_type.children.size());
 		for (idx_t c = 0; c < pg_type.children.size(); c++) {
-			if (!PostgresUtils::SupportedPostgresOid(children[c].second)) {
+			if (!SupportsBinaryElement(children[c].second, pg_type.children[c])) {
 				return true;
 			}
 			if (CopyRequiresText(children[c].second, pg_type.children[c])) {
@@ -24,7 +24,7 @@ string PostgresTableSet::GetInitializeQuery(const string &schema, const string &
 SELECT pg_namespace.oid AS namespace_id, relname, relpages, attname,
     pg_type.typname type_name, atttypmod type_modifier, pg_attribute.attndims ndim,
     attnum, pg_attribute.attnotnull AS notnull, NULL constraint_id,
-    NULL constraint_type, NULL constraint_key
+    NULL constraint_type, NULL constraint_key, reltuples, atttypid type_oid
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_attribute ON pg_class.oid=pg_attribute.attrelid
@@ -34,7 +34,7 @@ UNION ALL
 SELECT pg_namespace.oid AS namespace_id, relname, NULL relpages, NULL attname, NULL type_name,
     NULL type_modifier, NULL ndim, NULL attnum, NULL AS notnull,
     pg_constraint.oid AS constraint_id, contype AS constraint_type,
-    conkey AS constraint_key
+    conkey AS constraint_key, NULL reltuples, NULL type_oid
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_constraint ON (pg_class.oid=pg_constraint.conrelid)
@@ -51,6 +51,16 @@ ORDER BY namespace_id, relname, attnum, constraint_id;
 	return StringUtil::Replace(base_query, "${CONDITION}", condition);
 }
 
+idx_t PostgresTableSet::GetApproxNumRows(PostgresResult &result, idx_t row) {
+	// reltuples is -1 (or 0 prior to Postgres 14) if the table has never been vacuumed or analyzed
+	idx_t column_index = 12;
+	if (result.IsNull(row, column_index)) {
+		return 0;
+	}
+	auto reltuples = result.GetDouble(row, column_index);
+	return reltuples > 0 ? idx_t(reltuples) : 0;
+}
+
 void PostgresTableSet::AddColumn(optional_ptr<PostgresTransaction> transaction,
                                  optional_ptr<PostgresSchemaEntry> schema, PostgresResult &result, idx_t row,
                                  PostgresTableInfo &table_info) {
@@ -65,6 +75,7 @@ void PostgresTableSet::AddColumn(optional_ptr<PostgresTransaction> transaction,
 
 	PostgresType postgres_type;
 	auto column_type = PostgresUtils::TypeToLogicalType(transaction, schema, type_info, postgres_type);
+	postgres_type.oid = result.GetInt64(row, 13);
 	table_info.postgres_types.push_back(std::move(postgres_type));
 	table_info.postgres_names.push_back(column_name);
 	ColumnDefinition column(std::move(column_name), std::move(column_type));
@@ -131,6 +142,7 @@ void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresR
 			auto approx_num_pages = result.IsNull(row, 2) ? 0 : result.GetInt64(row, 2);
 			info = make_uniq<PostgresTableInfo>(schema, table_name);
 			info->approx_num_pages = approx_num_pages;
+			info->approx_num_rows = GetApproxNumRows(result, row);
 		}
 		AddColumnOrConstraint(&transaction, &schema, result, row, *info);
 	}
@@ -170,6 +182,7 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresTransaction
 		AddColumnOrConstraint(&transaction, &schema, *result, row, *table_info);
 	}
 	table_info->approx_num_pages = result->GetInt64(0, 2);
+	table_info->approx_num_rows = GetApproxNumRows(*result, 0);
 	return table_info;
 }
 
@@ -186,6 +199,7 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresConnection
 		AddColumnOrConstraint(nullptr, nullptr, *result, row, *table_info);
 	}
 	table_info->approx_num_pages = result->GetInt64(0, 2);
+	table_info->approx_num_rows = GetApproxNumRows(*result, 0);
 	return table_info;
 }
 
@@ -3,6 +3,7 @@
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
 #include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "postgres_result.hpp"
 
 namespace duckdb {
@@ -10,7 +11,7 @@ namespace duckdb {
 PostgresTransaction::PostgresTransaction(PostgresCatalog &postgres_catalog, TransactionManager &manager,
                                          ClientContext &context)
     : Transaction(manager, context), access_mode(postgres_catalog.access_mode),
-      isolation_level(postgres_catalog.isolation_level) {
+      isolation_level(postgres_catalog.isolation_level), version(postgres_catalog.GetPostgresVersion()) {
 	connection = postgres_catalog.GetConnectionPool().GetConnection();
 }
 
@@ -26,14 +27,62 @@ void PostgresTransaction::Start() {
 void PostgresTransaction::Commit() {
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_FINISHED;
-		GetConnectionRaw().Execute("COMMIT");
+		try {
+			GetConnectionRaw().Execute("COMMIT");
+		} catch (...) {
+			// the transaction could not be committed - neither can the transactions prepared alongside it
+			RollbackPreparedTransactions();
+			throw;
+		}
+	}
+	lock_guard<mutex> guard(prepared_lock);
+	auto &con = GetConnectionRaw();
+	// attempt to commit every prepared transaction - the ones that fail stay prepared (and keep their locks) until
+	// they are committed or rolled back manually, so report them by name
+	vector<string> failed_transactions;
+	string error;
+	for (auto &gid : prepared_transactions) {
+		string gid_error;
+		if (!con.TryQuery("COMMIT PREPARED " + KeywordHelper::WriteQuoted(gid, '\''), &gid_error)) {
+			failed_transactions.push_back(gid);
+			if (error.empty()) {
+				error = gid_error;
+			}
+		}
+	}
+	prepared_transactions.clear();
+	if (!failed_transactions.empty()) {
+		throw IOException("Failed to commit the prepared transactions %s of a parallel insert - the rows inserted "
+		                  "by these transactions are not visible, and they remain prepared until they are committed "
+		                  "(COMMIT PREPARED) or rolled back (ROLLBACK PREPARED) manually: %s",
+		                  StringUtil::Join(failed_transactions, ", "), error);
 	}
 }
 void PostgresTransaction::Rollback() {
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_FINISHED;
-		GetConnectionRaw().Execute("ROLLBACK");
+		try {
+			GetConnectionRaw().Execute("ROLLBACK");
+		} catch (...) {
+			RollbackPreparedTransactions();
+			throw;
+		}
+	}
+	RollbackPreparedTransactions();
+}
+
+void PostgresTransaction::RollbackPreparedTransactions() {
+	lock_guard<mutex> guard(prepared_lock);
+	auto &con = GetConnectionRaw();
+	for (auto &gid : prepared_transactions) {
+		con.TryQuery("ROLLBACK PREPARED " + KeywordHelper::WriteQuoted(gid, '\''));
 	}
+	prepared_transactions.clear();
+}
+
+void PostgresTransaction::AddPreparedTransaction(const string &gid) {
+	lock_guard<mutex> guard(prepared_lock);
+	prepared_transactions.push_back(gid);
 }
 
 string PostgresTransaction::GetBeginTransactionQuery() {
@@ -64,10 +113,12 @@ PostgresConnection &PostgresTransaction::GetConnectionWithoutTransaction() {
 	if (access_mode == AccessMode::READ_ONLY) {
 		throw std::runtime_error("Execution without a Transaction is not possible in Read Only Mode");
 	}
-	return connection.GetConnection();
+	WaitForBackgroundReads();
+	return GetConnectionRaw();
 }
 
 PostgresConnection &PostgresTransaction::GetConnection() {
+	WaitForBackgroundReads();
 	auto &con = GetConnectionRaw();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_NOT_YET_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_STARTED;
@@ -81,11 +132,30 @@ PostgresConnection &PostgresTransaction::GetConnectionRaw() {
 	return connection.GetConnection();
 }
 
+void PostgresTransaction::WaitForBackgroundReads() {
+	unique_lock<mutex> guard(background_read_lock);
+	background_reads_finished.wait(guard, [&]() { return active_background_reads == 0; });
+}
+
+void PostgresTransaction::BeginBackgroundRead() {
+	lock_guard<mutex> guard(background_read_lock);
+	active_background_reads++;
+}
+
+void PostgresTransaction::EndBackgroundRead() {
+	{
+		lock_guard<mutex> guard(background_read_lock);
+		active_background_reads--;
+	}
+	background_reads_finished.notify_all();
+}
+
 string PostgresTransaction::GetDSN() {
 	return GetConnectionRaw().GetDSN();
 }
 
 unique_ptr<PostgresResult> PostgresTransaction::Query(const string &query) {
+	WaitForBackgroundReads();
 	auto &con = GetConnectionRaw();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_NOT_YET_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_STARTED;
@@ -97,6 +167,7 @@ unique_ptr<PostgresResult> PostgresTransaction::Query(const string &query) {
 }
 
 unique_ptr<PostgresResult> PostgresTransaction::QueryWithoutTransaction(const string &query) {
+	WaitForBackgroundReads();
 	auto &con = GetConnectionRaw();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		throw std::runtime_error("Execution without a Transaction is not possible if a Transaction already started");
@@ -108,6 +179,7 @@ unique_ptr<PostgresResult> PostgresTransaction::QueryWithoutTransaction(const st
 }
 
 vector<unique_ptr<PostgresResult>> PostgresTransaction::ExecuteQueries(const string &queries) {
+	WaitForBackgroundReads();
 	auto &con = GetConnectionRaw();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_NOT_YET_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_STARTED;
@@ -141,6 +213,76 @@ string PostgresTransaction::GetTemporarySchema() {
 	return temporary_schema;
 }
 
+bool PostgresTransaction::CanExportSnapshot() {
+	lock_guard<mutex> guard(snapshot_lock);
+	if (snapshot_unavailable) {
+		return false;
+	}
+	// txid_current_if_assigned was introduced in PostgreSQL 9.6
+	if (version.type_v == PostgresInstanceType::AURORA || version.type_v == PostgresInstanceType::REDSHIFT ||
+	    version < PostgresVersion(9, 6, 0)) {
+		snapshot_unavailable = true;
+		return false;
+	}
+	return true;
+}
+
+string PostgresTransaction::GetSnapshot() {
+	if (!CanExportSnapshot()) {
+		return string();
+	}
+	lock_guard<mutex> guard(snapshot_lock);
+	auto query_id = active_query.load();
+	if (!snapshot.empty() && snapshot_query == query_id) {
+		// the snapshot is exported once per query - writes made by the query itself are not visible to its scans
+		return snapshot;
+	}
+	// with repeatable read (or serializable) the snapshot of the transaction does not change between queries -
+	// we only need to verify that the transaction has not written since the snapshot was exported
+	bool reuse_snapshot = !snapshot.empty() && isolation_level != PostgresIsolationLevel::READ_COMMITTED;
+	string query = "SELECT txid_current_if_assigned() IS NULL, pg_is_in_recovery() OR EXISTS (SELECT * FROM "
+	               "pg_stat_wal_receiver)";
+	if (!reuse_snapshot) {
+		query += ", pg_export_snapshot()";
+	}
+	auto result = GetConnection().TryQuery(query);
+	if (!result || !result->GetBool(0, 0) || result->GetBool(0, 1)) {
+		// the transaction has written, or we are connected to a replica - scans have to use the connection itself
+		snapshot = string();
+		snapshot_unavailable = true;
+		return snapshot;
+	}
+	if (!reuse_snapshot) {
+		snapshot = result->GetString(0, 2);
+	}
+	snapshot_query = query_id;
+	return snapshot;
+}
+
+bool PostgresTransaction::HasWritten() {
+	if (written_elsewhere) {
+		return true;
+	}
+	if (transaction_state != PostgresTransactionState::TRANSACTION_STARTED) {
+		return false;
+	}
+	if (version.type_v == PostgresInstanceType::AURORA || version.type_v == PostgresInstanceType::REDSHIFT ||
+	    version < PostgresVersion(9, 6, 0)) {
+		// txid_current_if_assigned is not available - assume the transaction has written
+		return true;
+	}
+	WaitForBackgroundReads();
+	auto result = GetConnectionRaw().TryQuery("SELECT txid_current_if_assigned() IS NOT NULL");
+	return !result || result->GetBool(0, 0);
+}
+
+void PostgresTransaction::MarkWritten() {
+	written_elsewhere = true;
+	lock_guard<mutex> guard(snapshot_lock);
+	snapshot = string();
+	snapshot_unavailable = true;
+}
+
 PostgresTransaction &PostgresTransaction::Get(ClientContext &context, Catalog &catalog) {
 	return Transaction::Get(context, catalog).Cast<PostgresTransaction>();
 }
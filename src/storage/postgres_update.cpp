@@ -208,7 +208,7 @@ PhysicalOperator &PostgresCatalog::PlanUpdate(ClientContext &context, PhysicalPl
 		throw BinderException("RETURNING clause not yet supported for updates of a Postgres table");
 	}
 
-	PostgresCatalog::MaterializePostgresScans(plan);
+	PostgresCatalog::MaterializePostgresScans(context, plan);
 	auto &update = planner.Make<PostgresUpdate>(op, op.table, std::move(op.columns), std::move(op.expressions));
 	update.children.push_back(plan);
 	return update;